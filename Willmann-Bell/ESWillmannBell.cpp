@@ -20,14 +20,17 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <assert.h>
 #include <math.h>
+#include <time.h>
 
 #include <string>
 
 #include "ESUtil.hpp"
 
 #include "Lunar/ESWBLunarTable.h"
+#include "Lunar/ESWBLunarMultiples.h"
 #include "Planets/ESWBPlanetsTable.h"
 
 #include "../src/ESAstroConstants.hpp"
@@ -267,7 +270,7 @@ static double deltaTForUT(double t) {
     }
 } 
 
-r// return in centuries since 2000 epoch
+// return in centuries since 2000 epoch
 static double TDTForUTDate(int yr,   // 1986, or -2 for 3 BC
 			   int mo,   // 1-12
 			   int dy,
@@ -280,6 +283,522 @@ static double TDTForUTDate(int yr,   // 1986, or -2 for 3 BC
 }
 #endif  // STANDALONE
 
+// The Delaunay fundamental arguments D, l', l, and F (the Moon's mean elongation, the Sun's and the Moon's mean
+// anomalies, and the Moon's argument of latitude), in degrees, as coefficients of t^0..t^4 scaled like the arguments in
+// the lunar tables.  Nearly every argument in the main series, and many of those in the slower series, is a small
+// integer combination of these (plus a small residual), so taking the sine and cosine of each of the four once per
+// instant and building the multiples by recurrence gives those terms' sines and cosines without further calls to sin().
+#define LUNAR_NUM_ARGUMENTS 4
+#define LUNAR_MAX_MULTIPLE 6
+static const double lunarFundamentalArguments[LUNAR_NUM_ARGUMENTS][5] = {
+    { 297.8502042, 445267.1115168, -16.300,  1.832, -0.884 },  // D
+    { 357.5291092,  35999.0502909,  -1.536,  0.041,  0     },  // l'
+    { 134.9634114, 477198.8676313,  89.970, 14.348, -6.797 },  // l
+    {  93.2720993, 483202.0175273, -34.029, -0.284,  0.115 }   // F
+};
+
+// A term is only expressed in terms of the fundamental arguments if the residual stays under this (radians) over
+// the era, so that the residual's own sine and cosine can almost always come from a short series.  The search for
+// each term's multiples is done offline (see LUNARMULTIPLES); ESWBLunarMultiples.h holds the result.
+#define LUNAR_MAX_RESIDUAL 0.02
+#define LUNAR_RESIDUAL_ERA 60.0  // centuries
+#define LUNAR_SMALL_RESIDUAL 1E-3
+
+// Radian versions of the lunar tables, with the tables' 1E-4/1E-6/1E-8 scale factors folded into the coefficients, so
+// each term is just amplitude * sin(c0 + c1*t + c2*t^2 + c3*t^3 + c4*t^4).  The distance terms, which are cosines in
+// the source tables, get a quarter-turn phase shift so every series is a sum of sines.  Each table is sorted by
+// descending amplitude; the source tables are already in that order, so the Nv etc. prefixes select the same terms.
+//
+// A decomposed term's argument is instead the combination of the fundamental arguments given by its multiples plus
+// c1*t + ... + c4*t^4; its constant residual phase is folded into sinWeight and cosWeight, and c0 is zero.
+typedef struct _LunarTerm {
+    double      amplitude;
+    double      c0;
+    double      c1;
+    double      c2;
+    double      c3;
+    double      c4;
+    double      sinWeight;
+    double      cosWeight;
+    signed char multiples[LUNAR_NUM_ARGUMENTS];
+    bool        decomposed;
+} LunarTerm;
+
+// For the tables whose arguments are linear in t; decomposed against the linear parts of the fundamental arguments
+typedef struct _LunarShortTerm {
+    double      amplitude;
+    double      c0;
+    double      c1;
+    double      sinWeight;
+    double      cosWeight;
+    signed char multiples[LUNAR_NUM_ARGUMENTS];
+    bool        decomposed;
+} LunarShortTerm;
+
+#define NUM_LUNAR_TERMS(table) ((int)(sizeof(table) / sizeof(table[0])))
+
+typedef struct _LunarSeriesTables {
+    LunarTerm      v[NUM_LUNAR_TERMS(Sv)];
+    LunarShortTerm v1[NUM_LUNAR_TERMS(Sv1)];
+    LunarShortTerm v2[NUM_LUNAR_TERMS(Sv2)];
+    LunarShortTerm v3[NUM_LUNAR_TERMS(Sv3)];
+    LunarTerm      u[NUM_LUNAR_TERMS(Su)];
+    LunarShortTerm u1[NUM_LUNAR_TERMS(Su1)];
+    LunarShortTerm u2[NUM_LUNAR_TERMS(Su2)];
+    LunarShortTerm u3[NUM_LUNAR_TERMS(Su3)];
+    LunarTerm      r[NUM_LUNAR_TERMS(Sr)];
+    LunarShortTerm r1[NUM_LUNAR_TERMS(Sr1)];
+    LunarShortTerm r2[NUM_LUNAR_TERMS(Sr2)];
+    LunarShortTerm r3[NUM_LUNAR_TERMS(Sr3)];
+} LunarSeriesTables;
+
+// Stable, and linear when (as here) the input is already sorted
+template <class TermType>
+static void
+sortLunarTermsByAmplitude(TermType *terms,
+			  int      numTerms) {
+    for (int i = 1; i < numTerms; i++) {
+	TermType term = terms[i];
+	int j = i;
+	while (j > 0 && fabs(terms[j - 1].amplitude) < fabs(term.amplitude)) {
+	    terms[j] = terms[j - 1];
+	    j--;
+	}
+	terms[j] = term;
+    }
+}
+
+// The fundamental arguments in radians, scaled like the coefficients of a LunarTerm
+static void
+lunarFundamentalArgumentsInRadians(double arguments[LUNAR_NUM_ARGUMENTS][5]) {
+    const double scales[5] = { M_PI / 180, M_PI / 180, 1E-4 * M_PI / 180, 1E-6 * M_PI / 180, 1E-8 * M_PI / 180 };
+    for (int i = 0; i < LUNAR_NUM_ARGUMENTS; i++) {
+	for (int j = 0; j < 5; j++) {
+	    arguments[i][j] = lunarFundamentalArguments[i][j] * scales[j];
+	}
+    }
+}
+
+// Replaces coefficients[] (only the first numCoefficients) with the residual after subtracting the given combination
+// of the fundamental arguments, taken from ESWBLunarMultiples.h.  Returns false, leaving coefficients[] alone, for a
+// term with no such combination.
+static bool
+applyLunarArgumentMultiples(double            coefficients[5],
+			    int               numCoefficients,
+			    const signed char tableMultiples[LUNAR_NUM_ARGUMENTS],
+			    signed char       multiples[LUNAR_NUM_ARGUMENTS]) {
+    static const signed char noMultiples[LUNAR_NUM_ARGUMENTS] = LUNAR_NO_MULTIPLES;
+    if (memcmp(tableMultiples, noMultiples, sizeof(noMultiples)) == 0) {
+	return false;
+    }
+    double fundamental[LUNAR_NUM_ARGUMENTS][5];
+    lunarFundamentalArgumentsInRadians(fundamental);
+    for (int c = 0; c < numCoefficients; c++) {
+	for (int a = 0; a < LUNAR_NUM_ARGUMENTS; a++) {
+	    coefficients[c] -= tableMultiples[a] * fundamental[a][c];
+	}
+    }
+    for (int a = 0; a < LUNAR_NUM_ARGUMENTS; a++) {
+	multiples[a] = tableMultiples[a];
+    }
+    return true;
+}
+
+static void
+fillLunarTerm(LunarTerm         *term,
+	      const signed char multiples[LUNAR_NUM_ARGUMENTS],
+	      double            amplitude,
+	      double            phase,
+	      double            a0,
+	      double            a1,
+	      double            a2,
+	      double            a3,
+	      double            a4) {
+    double coefficients[5] = {
+	a0 * (M_PI / 180) + phase,
+	a1 * (M_PI / 180),
+	a2 * (1E-4 * M_PI / 180),
+	a3 * (1E-6 * M_PI / 180),
+	a4 * (1E-8 * M_PI / 180)
+    };
+    term->amplitude = amplitude;
+    term->decomposed = applyLunarArgumentMultiples(coefficients, 5, multiples, term->multiples);
+    term->sinWeight = amplitude * cos(coefficients[0]);
+    term->cosWeight = amplitude * sin(coefficients[0]);
+    term->c0 = term->decomposed ? 0 : coefficients[0];
+    term->c1 = coefficients[1];
+    term->c2 = coefficients[2];
+    term->c3 = coefficients[3];
+    term->c4 = coefficients[4];
+}
+
+static void
+fillLunarShortTerm(LunarShortTerm    *term,
+		   const signed char multiples[LUNAR_NUM_ARGUMENTS],
+		   double            amplitude,
+		   double            phase,
+		   double            a0,
+		   double            a1) {
+    double coefficients[5] = {
+	a0 * (M_PI / 180) + phase,
+	a1 * (M_PI / 180)
+    };
+    term->amplitude = amplitude;
+    term->decomposed = applyLunarArgumentMultiples(coefficients, 2, multiples, term->multiples);
+    term->sinWeight = amplitude * cos(coefficients[0]);
+    term->cosWeight = amplitude * sin(coefficients[0]);
+    term->c0 = term->decomposed ? 0 : coefficients[0];
+    term->c1 = coefficients[1];
+}
+
+#define FILL_LUNAR_TERMS(dest, src, amp, arg, phase)			\
+    for (int i = 0; i < NUM_LUNAR_TERMS(src); i++) {			\
+	fillLunarTerm(&dest[i], src##Multiples[i], src[i].amp, phase,	\
+		      src[i].arg##0, src[i].arg##1, src[i].arg##2,	\
+		      src[i].arg##3, src[i].arg##4);			\
+    }									\
+    sortLunarTermsByAmplitude(dest, NUM_LUNAR_TERMS(src))
+
+#define FILL_LUNAR_SHORT_TERMS(dest, src, amp, arg, phase)		\
+    for (int i = 0; i < NUM_LUNAR_TERMS(src); i++) {			\
+	fillLunarShortTerm(&dest[i], src##Multiples[i], src[i].amp,	\
+			   phase, src[i].arg##0, src[i].arg##1);	\
+    }									\
+    sortLunarTermsByAmplitude(dest, NUM_LUNAR_TERMS(src))
+
+static const LunarSeriesTables *
+makeLunarSeriesTables() {
+    LunarSeriesTables *tables = (LunarSeriesTables *)malloc(sizeof(LunarSeriesTables));
+    FILL_LUNAR_TERMS(tables->v, Sv, vn, an, 0);
+    FILL_LUNAR_SHORT_TERMS(tables->v1, Sv1, vn, an, 0);
+    FILL_LUNAR_SHORT_TERMS(tables->v2, Sv2, vn, an, 0);
+    FILL_LUNAR_SHORT_TERMS(tables->v3, Sv3, vn, an, 0);
+    FILL_LUNAR_TERMS(tables->u, Su, un, bn, 0);
+    FILL_LUNAR_SHORT_TERMS(tables->u1, Su1, un, bn, 0);
+    FILL_LUNAR_SHORT_TERMS(tables->u2, Su2, un, bn, 0);
+    FILL_LUNAR_SHORT_TERMS(tables->u3, Su3, un, bn, 0);
+    FILL_LUNAR_TERMS(tables->r, Sr, rn, dn, M_PI / 2);
+    FILL_LUNAR_SHORT_TERMS(tables->r1, Sr1, rn, dn, M_PI / 2);
+    FILL_LUNAR_SHORT_TERMS(tables->r2, Sr2, rn, dn, M_PI / 2);
+    FILL_LUNAR_SHORT_TERMS(tables->r3, Sr3, rn, dn, M_PI / 2);
+    return tables;
+}
+
+#undef FILL_LUNAR_TERMS
+#undef FILL_LUNAR_SHORT_TERMS
+
+static const LunarSeriesTables *
+lunarSeriesTables() {
+    static const LunarSeriesTables *tables = makeLunarSeriesTables();
+    return tables;
+}
+
+// cos and sin of n times each fundamental argument, for n = -LUNAR_MAX_MULTIPLE..LUNAR_MAX_MULTIPLE
+typedef struct _LunarArgumentMultiples {
+    double cosMultiple[LUNAR_NUM_ARGUMENTS][2 * LUNAR_MAX_MULTIPLE + 1];
+    double sinMultiple[LUNAR_NUM_ARGUMENTS][2 * LUNAR_MAX_MULTIPLE + 1];
+} LunarArgumentMultiples;
+
+// Everything the series need at one instant.  The main series use the full fundamental arguments, the others (whose
+// arguments are linear in t) just their linear parts.
+typedef struct _LunarInstant {
+    double                 t;
+    double                 t2;
+    double                 t3;
+    double                 t4;
+    LunarArgumentMultiples multiples;
+    LunarArgumentMultiples linearMultiples;
+} LunarInstant;
+
+// Two sincos per argument; the multiples then come from cos((n+1)x) = 2cos(x)cos(nx) - cos((n-1)x) and likewise for sin
+static void
+setupLunarArgumentMultiples(const double           *arguments,
+			    LunarArgumentMultiples *multiples) {
+    for (int a = 0; a < LUNAR_NUM_ARGUMENTS; a++) {
+	double x = fmod(arguments[a], 2 * M_PI);
+	double *cosMultiple = multiples->cosMultiple[a] + LUNAR_MAX_MULTIPLE;
+	double *sinMultiple = multiples->sinMultiple[a] + LUNAR_MAX_MULTIPLE;
+	double twoCosX = 2 * cos(x);
+	cosMultiple[0] = 1;
+	sinMultiple[0] = 0;
+	cosMultiple[1] = twoCosX / 2;
+	sinMultiple[1] = sin(x);
+	for (int n = 2; n <= LUNAR_MAX_MULTIPLE; n++) {
+	    cosMultiple[n] = twoCosX * cosMultiple[n - 1] - cosMultiple[n - 2];
+	    sinMultiple[n] = twoCosX * sinMultiple[n - 1] - sinMultiple[n - 2];
+	}
+	for (int n = 1; n <= LUNAR_MAX_MULTIPLE; n++) {
+	    cosMultiple[-n] = cosMultiple[n];
+	    sinMultiple[-n] = -sinMultiple[n];
+	}
+    }
+}
+
+static void
+setupLunarInstant(double       t,
+		  LunarInstant *instant) {
+    instant->t = t;
+    instant->t2 = t*t;
+    instant->t3 = t*instant->t2;
+    instant->t4 = instant->t2*instant->t2;
+    double arguments[LUNAR_NUM_ARGUMENTS];
+    double linearArguments[LUNAR_NUM_ARGUMENTS];
+    for (int a = 0; a < LUNAR_NUM_ARGUMENTS; a++) {
+	const double *c = lunarFundamentalArguments[a];
+	double linear = c[0] + c[1] * t;
+	linearArguments[a] = linear * (M_PI / 180);
+	arguments[a] = (linear + 1E-4 * c[2] * instant->t2 + 1E-6 * c[3] * instant->t3 + 1E-8 * c[4] * instant->t4) * (M_PI / 180);
+    }
+    setupLunarArgumentMultiples(arguments, &instant->multiples);
+    setupLunarArgumentMultiples(linearArguments, &instant->linearMultiples);
+}
+
+// amplitude * sin(combination + residual phase + residual), the first two folded into the weights
+static inline double
+decomposedLunarTerm(const LunarArgumentMultiples *multiples,
+		    const signed char            termMultiples[LUNAR_NUM_ARGUMENTS],
+		    double                       sinWeight,
+		    double                       cosWeight,
+		    double                       residual) {
+    int n = termMultiples[0] + LUNAR_MAX_MULTIPLE;
+    double c = multiples->cosMultiple[0][n];
+    double s = multiples->sinMultiple[0][n];
+    for (int a = 1; a < LUNAR_NUM_ARGUMENTS; a++) {
+	n = termMultiples[a] + LUNAR_MAX_MULTIPLE;
+	double ca = multiples->cosMultiple[a][n];
+	double sa = multiples->sinMultiple[a][n];
+	double cNew = c * ca - s * sa;
+	s = s * ca + c * sa;
+	c = cNew;
+    }
+    double cosResidual;
+    double sinResidual;
+    if (fabs(residual) < LUNAR_SMALL_RESIDUAL) {
+	double residual2 = residual * residual;
+	cosResidual = 1 - residual2 / 2;
+	sinResidual = residual * (1 - residual2 / 6);
+    } else {
+	cosResidual = cos(residual);
+	sinResidual = sin(residual);
+    }
+    return cosResidual * (sinWeight * s + cosWeight * c) + sinResidual * (sinWeight * c - cosWeight * s);
+}
+
+static inline double
+sumLunarTerms(const LunarTerm    *terms,
+	      int                numTerms,
+	      const LunarInstant *instant) {
+    double t = instant->t;
+    double t2 = instant->t2;
+    double t3 = instant->t3;
+    double t4 = instant->t4;
+    double sum = 0;
+    for (int i = 0; i < numTerms; i++) {
+	const LunarTerm *term = &terms[i];
+	double argument = term->c0 + term->c1 * t + term->c2 * t2 + term->c3 * t3 + term->c4 * t4;
+	if (term->decomposed) {
+	    sum += decomposedLunarTerm(&instant->multiples, term->multiples, term->sinWeight, term->cosWeight, argument);
+	} else {
+	    sum += term->amplitude * sin(argument);
+	}
+    }
+    return sum;
+}
+
+static inline double
+sumLunarShortTerms(const LunarShortTerm *terms,
+		   int                  numTerms,
+		   const LunarInstant   *instant) {
+    double t = instant->t;
+    double sum = 0;
+    for (int i = 0; i < numTerms; i++) {
+	const LunarShortTerm *term = &terms[i];
+	double argument = term->c0 + term->c1 * t;
+	if (term->decomposed) {
+	    sum += decomposedLunarTerm(&instant->linearMultiples, term->multiples, term->sinWeight, term->cosWeight, argument);
+	} else {
+	    sum += term->amplitude * sin(argument);
+	}
+    }
+    return sum;
+}
+
+// Choose how many terms of each of the four series (main, 1, 2, 3) making up one quantity to sum so that the omitted
+// terms can contribute at most the given tolerance (in the series' own units).  Each series is scaled by its weight
+// (which for series 2 and 3 includes the worst-case power of t over the era), so a term's worst-case contribution is
+// its amplitude times that weight.  Since each table is sorted by amplitude, adding terms greedily in order of
+// weighted amplitude gives the fewest terms meeting the bound.
+static void
+planLunarSeries(double               tolerance,
+		const double         weights[4],
+		const LunarTerm      *mainTerms,
+		int                  numMainTerms,
+		const LunarShortTerm *series1Terms,
+		int                  numSeries1Terms,
+		const LunarShortTerm *series2Terms,
+		int                  numSeries2Terms,
+		const LunarShortTerm *series3Terms,
+		int                  numSeries3Terms,
+		int                  numTerms[4]) {
+    const int availableTerms[4] = { numMainTerms, numSeries1Terms, numSeries2Terms, numSeries3Terms };
+    double omitted = 0;
+    for (int i = 0; i < numMainTerms; i++) {
+	omitted += weights[0] * fabs(mainTerms[i].amplitude);
+    }
+    for (int i = 0; i < numSeries1Terms; i++) {
+	omitted += weights[1] * fabs(series1Terms[i].amplitude);
+    }
+    for (int i = 0; i < numSeries2Terms; i++) {
+	omitted += weights[2] * fabs(series2Terms[i].amplitude);
+    }
+    for (int i = 0; i < numSeries3Terms; i++) {
+	omitted += weights[3] * fabs(series3Terms[i].amplitude);
+    }
+    for (int series = 0; series < 4; series++) {
+	numTerms[series] = 0;
+    }
+    while (omitted > tolerance) {
+	double largest = -1;
+	int largestSeries = -1;
+	for (int series = 0; series < 4; series++) {
+	    int n = numTerms[series];
+	    if (n < availableTerms[series]) {
+		double amplitude =
+		    series == 0 ? mainTerms[n].amplitude :
+		    series == 1 ? series1Terms[n].amplitude :
+		    series == 2 ? series2Terms[n].amplitude :
+		                  series3Terms[n].amplitude;
+		double contribution = weights[series] * fabs(amplitude);
+		if (contribution > largest) {
+		    largest = contribution;
+		    largestSeries = series;
+		}
+	    }
+	}
+	if (largestSeries < 0) {  // everything is already included
+	    break;
+	}
+	numTerms[largestSeries]++;
+	omitted -= largest;
+    }
+}
+
+void WB_lunarSeriesPlanForTolerance(double              longitudeArcseconds,
+				    double              latitudeArcseconds,
+				    double              distanceKm,
+				    double              maxAbsCenturiesSinceEpochTDT,
+				    ECWBLunarSeriesPlan *plan) {
+    const LunarSeriesTables *tables = lunarSeriesTables();
+    double T = fabs(maxAbsCenturiesSinceEpochTDT);
+    // As combined in lunarLongitudeSeriesForPlan etc.
+    const double angleWeights[4] = { 1, 1E-3, 1E-3 * T, 1E-7 * T * T };
+    const double distanceWeights[4] = { 1, 1, T, 1E-4 * T * T };
+    planLunarSeries(longitudeArcseconds / 3600, angleWeights,
+		    tables->v, NUM_LUNAR_TERMS(Sv), tables->v1, NUM_LUNAR_TERMS(Sv1),
+		    tables->v2, NUM_LUNAR_TERMS(Sv2), tables->v3, NUM_LUNAR_TERMS(Sv3),
+		    plan->longitudeTerms);
+    planLunarSeries(latitudeArcseconds / 3600, angleWeights,
+		    tables->u, NUM_LUNAR_TERMS(Su), tables->u1, NUM_LUNAR_TERMS(Su1),
+		    tables->u2, NUM_LUNAR_TERMS(Su2), tables->u3, NUM_LUNAR_TERMS(Su3),
+		    plan->latitudeTerms);
+    planLunarSeries(distanceKm, distanceWeights,
+		    tables->r, NUM_LUNAR_TERMS(Sr), tables->r1, NUM_LUNAR_TERMS(Sr1),
+		    tables->r2, NUM_LUNAR_TERMS(Sr2), tables->r3, NUM_LUNAR_TERMS(Sr3),
+		    plan->distanceTerms);
+}
+
+// Returns DEGREES, not yet reduced
+static double lunarLongitudeSeriesForPlan(const LunarInstant        *instant,
+					  const ECWBLunarSeriesPlan *plan) {
+    const LunarSeriesTables *tables = lunarSeriesTables();
+    double t = instant->t;
+    double t2 = instant->t2;
+    double SV = sumLunarTerms(tables->v, plan->longitudeTerms[0], instant);
+    double SV1 = sumLunarShortTerms(tables->v1, plan->longitudeTerms[1], instant);
+    double SV2 = sumLunarShortTerms(tables->v2, plan->longitudeTerms[2], instant);
+    double SV3 = sumLunarShortTerms(tables->v3, plan->longitudeTerms[3], instant);
+    return 218.31665436 +
+	481267.88134240 * t -
+	13.268E-4 * t2 +
+	1.856E-6 * instant->t3 -
+	1.534E-8 * instant->t4 +
+	SV +
+	(1E-3)*(SV1 + t * SV2 + t2*(1E-4)*SV3);
+}
+
+// Returns DEGREES, not yet reduced
+static double lunarLatitudeSeriesForPlan(const LunarInstant        *instant,
+					 const ECWBLunarSeriesPlan *plan) {
+    const LunarSeriesTables *tables = lunarSeriesTables();
+    double t = instant->t;
+    double t2 = instant->t2;
+    double SU = sumLunarTerms(tables->u, plan->latitudeTerms[0], instant);
+    double SU1 = sumLunarShortTerms(tables->u1, plan->latitudeTerms[1], instant);
+    double SU2 = sumLunarShortTerms(tables->u2, plan->latitudeTerms[2], instant);
+    double SU3 = sumLunarShortTerms(tables->u3, plan->latitudeTerms[3], instant);
+    return SU +
+	(1E-3)*(SU1 + t * SU2 + t2*(1E-4)*SU3);
+}
+
+// Returns km
+static double lunarDistanceSeriesForPlan(const LunarInstant        *instant,
+					 const ECWBLunarSeriesPlan *plan) {
+    const LunarSeriesTables *tables = lunarSeriesTables();
+    double t = instant->t;
+    double t2 = instant->t2;
+    double SR = sumLunarTerms(tables->r, plan->distanceTerms[0], instant);
+    double SR1 = sumLunarShortTerms(tables->r1, plan->distanceTerms[1], instant);
+    double SR2 = sumLunarShortTerms(tables->r2, plan->distanceTerms[2], instant);
+    double SR3 = sumLunarShortTerms(tables->r3, plan->distanceTerms[3], instant);
+    return 385000.57 +
+	SR + SR1 + t * SR2 + t2*(1E-4)*SR3;
+}
+
+// The fixed plans for each ECWBPrecision, from the term counts in ESWBLunarTable.h
+static const ECWBLunarSeriesPlan lunarSeriesPlans[3] = {
+    { { Nv[0], N1v[0], N2v[0], N3v[0] }, { Nu[0], N1u[0], N2u[0], N3u[0] }, { Nr[0], N1r[0], N2r[0], N3r[0] } },
+    { { Nv[1], N1v[1], N2v[1], N3v[1] }, { Nu[1], N1u[1], N2u[1], N3u[1] }, { Nr[1], N1r[1], N2r[1], N3r[1] } },
+    { { Nv[2], N1v[2], N2v[2], N3v[2] }, { Nu[2], N1u[2], N2u[2], N3u[2] }, { Nr[2], N1r[2], N2r[2], N3r[2] } }
+};
+
+static double reducedLunarLongitude(double V) {
+    return ESUtil::fmod(V, 360.0);
+}
+
+static double reducedLunarLatitude(double U) {
+    U = ESUtil::fmod(U, 360.0);
+    if (U > 180) {
+	U -= 360;
+    }
+    return U;
+}
+
+// The three series share the fundamental arguments, and anyone asking for one of the Moon's coordinates almost always
+// wants the others at the same instant, so with a cache all three are computed and stored together.  Returns DEGREES
+// (reduced) and km.
+static void lunarPositionForTDT(double        t,
+				ECWBPrecision p,
+				ECAstroCache  *currentCache,
+				double        *V,
+				double        *U,
+				double        *R) {
+    assert(currentCache);
+    LunarInstant instant;
+    setupLunarInstant(t, &instant);
+    *V = reducedLunarLongitude(lunarLongitudeSeriesForPlan(&instant, &lunarSeriesPlans[p]));
+    *U = reducedLunarLatitude(lunarLatitudeSeriesForPlan(&instant, &lunarSeriesPlans[p]));
+    *R = lunarDistanceSeriesForPlan(&instant, &lunarSeriesPlans[p]);
+    int longitudeSlotIndex = WBLunarLongitudeLowSlotIndex + p;
+    int latitudeSlotIndex = WBLunarLatitudeLowSlotIndex + p;
+    int distanceSlotIndex = WBLunarDistanceLowSlotIndex + p;
+    currentCache->cacheSlotValidFlag[longitudeSlotIndex] = currentCache->currentFlag;
+    currentCache->cacheSlotValidFlag[latitudeSlotIndex] = currentCache->currentFlag;
+    currentCache->cacheSlotValidFlag[distanceSlotIndex] = currentCache->currentFlag;
+    currentCache->cacheSlots[longitudeSlotIndex] = *V;
+    currentCache->cacheSlots[latitudeSlotIndex] = *U;
+    currentCache->cacheSlots[distanceSlotIndex] = *R;
+}
+
 // Returns DEGREES
 static double lunarLongitudeForTDT(double        t,
 				   ECWBPrecision p,
@@ -290,69 +809,13 @@ static double lunarLongitudeForTDT(double        t,
     double V;
     if (currentCache && currentCache->cacheSlotValidFlag[slotIndex] == currentCache->currentFlag) {
 	V = currentCache->cacheSlots[slotIndex];
+    } else if (currentCache) {
+	double U, R;
+	lunarPositionForTDT(t, p, currentCache, &V, &U, &R);
     } else {
-	double SV = 0;
-	//printf("Nv %d\n", Nv[p]);
-	const SvDatum *end = Sv + Nv[p];
-	double t2 = t*t;
-	double t3 = t*t2;
-	double t4 = t2*t2;
-	for (const SvDatum *datum = Sv; datum < end; datum++) {
-	    double sinArg =
-		datum->an0 +
-		datum->an1 * t +
-		datum->an2 * t2 * 1E-4 +
-		datum->an3 * t3 * 1E-6 +
-		datum->an4 * t4 * 1E-8;
-	    SV += datum->vn * sin((M_PI / 180) * sinArg);
-	}
-	//printf("SV %.4f\n", SV);
-	double SV1 = 0;
-	//printf("N1v %d\n", N1v[p]);
-	const Sv1Datum *end1 = Sv1 + N1v[p];
-	for (const Sv1Datum *datum = Sv1; datum < end1; datum++) {
-	    //printf("datum: vn=%.2f, an0=%.2f, an1=%.2f\n", datum->vn, datum->an0, datum->an1);
-	    double sinArg =
-		datum->an0 +
-		datum->an1 * t;
-	    SV1 += datum->vn * sin((M_PI / 180) * sinArg);
-	}
-	//printf("SV1 %.4f\n", SV1);
-	//printf("N2v %d\n", N2v[p]);
-	double SV2 = 0;
-	const Sv2Datum *end2 = Sv2 + N2v[p];
-	for (const Sv2Datum *datum = Sv2; datum < end2; datum++) {
-	    double sinArg =
-		datum->an0 +
-		datum->an1 * t;
-	    SV2 += datum->vn * sin((M_PI / 180) * sinArg);
-	}
-	//printf("SV2 %.4f\n", SV2);
-	//printf("N3v %d\n", N3v[p]);
-	double SV3 = 0;
-	const Sv3Datum *end3 = Sv3 + N3v[p];
-	for (const Sv3Datum *datum = Sv3; datum < end3; datum++) {
-	    double sinArg =
-		datum->an0 +
-		datum->an1 * t;
-	    SV3 += datum->vn * sin((M_PI / 180) * sinArg);
-	}
-	//printf("SV3 %.4f\n", SV3);
-	//printf("t %.4f\n", t);
-	V = 218.31665436 +
-	    481267.88134240 * t -
-	    13.268E-4 * t2 +
-	    1.856E-6 * t3 -
-	    1.534E-8 * t4 +
-	    SV +
-	    (1E-3)*(SV1 + t * SV2 + t2*(1E-4)*SV3);
-	//printf("V %.4f\n", V);
-	V = ESUtil::fmod(V, 360.0);
-	//printf("V %.4f\n", V);
-	if (currentCache) {
-	    currentCache->cacheSlotValidFlag[slotIndex] = currentCache->currentFlag;
-	    currentCache->cacheSlots[slotIndex] = V;
-	}
+	LunarInstant instant;
+	setupLunarInstant(t, &instant);
+	V = reducedLunarLongitude(lunarLongitudeSeriesForPlan(&instant, &lunarSeriesPlans[p]));
     }
     return V;
 }
@@ -367,67 +830,13 @@ static double lunarLatitudeForTDT(double        t,
     double U;
     if (currentCache && currentCache->cacheSlotValidFlag[slotIndex] == currentCache->currentFlag) {
 	U = currentCache->cacheSlots[slotIndex];
+    } else if (currentCache) {
+	double V, R;
+	lunarPositionForTDT(t, p, currentCache, &V, &U, &R);
     } else {
-	double SU = 0;
-	//printf("Nu %d\n", Nu[p]);
-	const SuDatum *end = Su + Nu[p];
-	double t2 = t*t;
-	double t3 = t*t2;
-	double t4 = t2*t2;
-	for (const SuDatum *datum = Su; datum < end; datum++) {
-	    double sinArg =
-		datum->bn0 +
-		datum->bn1 * t +
-		datum->bn2 * t2 * 1E-4 +
-		datum->bn3 * t3 * 1E-6 +
-		datum->bn4 * t4 * 1E-8;
-	    SU += datum->un * sin((M_PI / 180) * sinArg);
-	}
-	//printf("SU %.4f\n", SU);
-	double SU1 = 0;
-	//printf("N1u %d\n", N1u[p]);
-	const Su1Datum *end1 = Su1 + N1u[p];
-	for (const Su1Datum *datum = Su1; datum < end1; datum++) {
-	    //printf("datum: un=%.2f, bn0=%.2f, bn1=%.2f\n", datum->un, datum->bn0, datum->bn1);
-	    double sinArg =
-		datum->bn0 +
-		datum->bn1 * t;
-	    SU1 += datum->un * sin((M_PI / 180) * sinArg);
-	}
-	//printf("SU1 %.4f\n", SU1);
-	//printf("N2u %d\n", N2u[p]);
-	double SU2 = 0;
-	const Su2Datum *end2 = Su2 + N2u[p];
-	for (const Su2Datum *datum = Su2; datum < end2; datum++) {
-	    double sinArg =
-		datum->bn0 +
-		datum->bn1 * t;
-	    SU2 += datum->un * sin((M_PI / 180) * sinArg);
-	}
-	//printf("SU2 %.4f\n", SU2);
-	//printf("N3u %d\n", N3u[p]);
-	double SU3 = 0;
-	const Su3Datum *end3 = Su3 + N3u[p];
-	for (const Su3Datum *datum = Su3; datum < end3; datum++) {
-	    double sinArg =
-		datum->bn0 +
-		datum->bn1 * t;
-	    SU3 += datum->un * sin((M_PI / 180) * sinArg);
-	}
-	//printf("SU3 %.4f\n", SU3);
-	//printf("t %.4f\n", t);
-	U = SU +
-	    (1E-3)*(SU1 + t * SU2 + t2*(1E-4)*SU3);
-	//printf("U %.4f\n", U);
-	U = ESUtil::fmod(U, 360.0);
-	if (U > 180) {
-	    U -= 360;
-	}
-	//printf("U %.4f\n", U);
-	if (currentCache) {
-	    currentCache->cacheSlotValidFlag[slotIndex] = currentCache->currentFlag;
-	    currentCache->cacheSlots[slotIndex] = U;
-	}
+	LunarInstant instant;
+	setupLunarInstant(t, &instant);
+	U = reducedLunarLatitude(lunarLatitudeSeriesForPlan(&instant, &lunarSeriesPlans[p]));
     }
     return U;
 }
@@ -442,61 +851,13 @@ static double lunarDistanceForTDT(double        t,
     double R;
     if (currentCache && currentCache->cacheSlotValidFlag[slotIndex] == currentCache->currentFlag) {
 	R = currentCache->cacheSlots[slotIndex];
+    } else if (currentCache) {
+	double V, U;
+	lunarPositionForTDT(t, p, currentCache, &V, &U, &R);
     } else {
-	double SR = 0;
-	//printf("Nr %d\n", Nr[p]);
-	const SrDatum *end = Sr + Nr[p];
-	double t2 = t*t;
-	double t3 = t*t2;
-	double t4 = t2*t2;
-	for (const SrDatum *datum = Sr; datum < end; datum++) {
-	    double cosArg =
-		datum->dn0 +
-		datum->dn1 * t +
-		datum->dn2 * t2 * 1E-4 +
-		datum->dn3 * t3 * 1E-6 +
-		datum->dn4 * t4 * 1E-8;
-	    SR += datum->rn * cos((M_PI / 180) * cosArg);
-	}
-	//printf("SR %.4f\n", SR);
-	double SR1 = 0;
-	//printf("N1r %d\n", N1r[p]);
-	const Sr1Datum *end1 = Sr1 + N1r[p];
-	for (const Sr1Datum *datum = Sr1; datum < end1; datum++) {
-	    //printf("datum: rn=%.2f, dn0=%.2f, dn1=%.2f\n", datum->rn, datum->dn0, datum->dn1);
-	    double cosArg =
-		datum->dn0 +
-		datum->dn1 * t;
-	    SR1 += datum->rn * cos((M_PI / 180) * cosArg);
-	}
-	//printf("SR1 %.4f\n", SR1);
-	//printf("N2r %d\n", N2r[p]);
-	double SR2 = 0;
-	const Sr2Datum *end2 = Sr2 + N2r[p];
-	for (const Sr2Datum *datum = Sr2; datum < end2; datum++) {
-	    double cosArg =
-		datum->dn0 +
-		datum->dn1 * t;
-	    SR2 += datum->rn * cos((M_PI / 180) * cosArg);
-	}
-	//printf("SR2 %.4f\n", SR2);
-	//printf("N3r %d\n", N3r[p]);
-	double SR3 = 0;
-	const Sr3Datum *end3 = Sr3 + N3r[p];
-	for (const Sr3Datum *datum = Sr3; datum < end3; datum++) {
-	    double cosArg =
-		datum->dn0 +
-		datum->dn1 * t;
-	    SR3 += datum->rn * cos((M_PI / 180) * cosArg);
-	}
-	//printf("SR3 %.4f\n", SR3);
-	//printf("t %.4f\n", t);
-	R = 385000.57 +
-	    SR + SR1 + t * SR2 + t2*(1E-4)*SR3;
-	if (currentCache) {
-	    currentCache->cacheSlotValidFlag[slotIndex] = currentCache->currentFlag;
-	    currentCache->cacheSlots[slotIndex] = R;
-	}
+	LunarInstant instant;
+	setupLunarInstant(t, &instant);
+	R = lunarDistanceSeriesForPlan(&instant, &lunarSeriesPlans[p]);
     }
     return R;
 }
@@ -685,6 +1046,35 @@ double WB_MoonDistance(double        centuriesSinceEpochTDT,
     return R;
 }
 
+// Same quantities as WB_MoonEclipticLongitude, WB_MoonEclipticLatitude, and WB_MoonDistance, but summing only the terms
+// in the given plan.  Not cached, since the cache slots are per ECWBPrecision.
+void WB_MoonPositionForPlan(double                    centuriesSinceEpochTDT,
+			    const ECWBLunarSeriesPlan *plan,
+			    double                    *longitudeReturn,
+			    double                    *latitudeReturn,
+			    double                    *distanceReturn) {
+    double t = centuriesSinceEpochTDT;
+    LunarInstant instant;
+    setupLunarInstant(t, &instant);
+    double V = reducedLunarLongitude(lunarLongitudeSeriesForPlan(&instant, plan));
+    double U = reducedLunarLatitude(lunarLatitudeSeriesForPlan(&instant, plan));
+    *longitudeReturn = V*M_PI/180 + lunarAberrationV(t);
+    *latitudeReturn = U*M_PI/180 + lunarAberrationU(t);
+    *distanceReturn = lunarDistanceSeriesForPlan(&instant, plan) + lunarAberrationR(t);
+}
+
+void WB_MoonPositionWithTolerance(double centuriesSinceEpochTDT,
+				  double longitudeArcseconds,
+				  double latitudeArcseconds,
+				  double distanceKm,
+				  double *longitudeReturn,
+				  double *latitudeReturn,
+				  double *distanceReturn) {
+    ECWBLunarSeriesPlan plan;
+    WB_lunarSeriesPlanForTolerance(longitudeArcseconds, latitudeArcseconds, distanceKm, centuriesSinceEpochTDT, &plan);
+    WB_MoonPositionForPlan(centuriesSinceEpochTDT, &plan, longitudeReturn, latitudeReturn, distanceReturn);
+}
+
 // radians
 static double ascendingNodeLongitude(double        centuriesSinceEpochTDT,
 				     ECWBPrecision p,
@@ -1014,6 +1404,21 @@ double WB_sunLongitudeAberration(double hundredCenturiesSinceEpochTDT) {
     return 1E-7*(-993 + 17*cos(3.10 + 62830.14*U));
 }
 
+// Straight-line, so that the batch loop below has no branches and can be vectorized by compilers with vector math
+static inline void
+nutationObliquityKernel(double U,
+			double *nutationReturn,
+			double *obliquityReturn) {
+    double U_2 = U * U;
+    double A1 = 2.18 - 3375.70*U + 0.36 * U_2;
+    double A2 = 3.51 + 125666.39*U + 0.10 * U_2;
+    *nutationReturn = 1E-7 * (-834*sin(A1) - 64*sin(A2));
+    double U_3 = U * U_2;
+    double U_4 = U_2 * U_2;
+    double U_5 = U * U_4;
+    *obliquityReturn = 0.4090928 + 1E-7 * (-226938*U - 75*U_2 + 96926*U_3 - 2491*U_4 - 12104*U_5 + 446*cos(A1) + 28*cos(A2));
+}
+
 void WB_nutationObliquity(double       hundredCenturiesSinceEpochTDT,
 			  double       *nutationReturn,
 			  double       *obliquityReturn,
@@ -1023,15 +1428,7 @@ void WB_nutationObliquity(double       hundredCenturiesSinceEpochTDT,
 	*nutationReturn = currentCache->cacheSlots[WBNutationSlotIndex];
 	*obliquityReturn = currentCache->cacheSlots[WBObliquitySlotIndex];
     } else {
-	double U = hundredCenturiesSinceEpochTDT;
-	double U_2 = U * U;
-	double A1 = 2.18 - 3375.70*U + 0.36 * U_2;
-	double A2 = 3.51 + 125666.39*U + 0.10 * U_2;
-	*nutationReturn = 1E-7 * (-834*sin(A1) - 64*sin(A2));
-	double U_3 = U * U_2;
-	double U_4 = U_2 * U_2;
-	double U_5 = U * U_4;
-	*obliquityReturn = 0.4090928 + 1E-7 * (-226938*U - 75*U_2 + 96926*U_3 - 2491*U_4 - 12104*U_5 + 446*cos(A1) + 28*cos(A2));
+	nutationObliquityKernel(hundredCenturiesSinceEpochTDT, nutationReturn, obliquityReturn);
 	if (currentCache) {
 	    currentCache->cacheSlotValidFlag[WBNutationSlotIndex] = currentCache->currentFlag;
 	    currentCache->cacheSlots[WBNutationSlotIndex] = *nutationReturn;
@@ -1040,6 +1437,37 @@ void WB_nutationObliquity(double       hundredCenturiesSinceEpochTDT,
     }
 }
 
+void WB_nutationObliquityBatch(const double *hundredCenturiesSinceEpochTDT,
+			       int          count,
+			       double       *nutationReturn,
+			       double       *obliquityReturn) {
+    for (int i = 0; i < count; i++) {
+	nutationObliquityKernel(hundredCenturiesSinceEpochTDT[i], &nutationReturn[i], &obliquityReturn[i]);
+    }
+}
+
+// radians
+static void sunApparentRAAndDecl(double longitude,
+				 double aberration,
+				 double nutation,
+				 double cosObliquity,
+				 double sinObliquity,
+				 double *rightAscensionReturn,
+				 double *declinationReturn,
+				 double *apparentLongitudeReturn) {
+    double apparentLongitude = longitude + aberration + nutation;
+    apparentLongitude = ESUtil::fmod(apparentLongitude, M_PI * 2);
+    if (apparentLongitude < 0) {
+	apparentLongitude += M_PI * 2;
+    }
+    *declinationReturn = asin(sinObliquity * sin(apparentLongitude));
+    *rightAscensionReturn = atan2(cosObliquity * sin(apparentLongitude), cos(apparentLongitude));
+    if (*rightAscensionReturn < 0) {
+	*rightAscensionReturn += M_PI * 2;
+    }
+    *apparentLongitudeReturn = apparentLongitude;
+}
+
 void WB_sunRAAndDecl(double 	  hundredCenturiesSinceEpochTDT,
 		     double 	  *rightAscensionReturn,
 		     double 	  *declinationReturn,
@@ -1050,17 +1478,8 @@ void WB_sunRAAndDecl(double 	  hundredCenturiesSinceEpochTDT,
     double nutation;
     double obliquity;
     WB_nutationObliquity(hundredCenturiesSinceEpochTDT, &nutation, &obliquity, currentCache);
-    double apparentLongitude = longitude + aberration + nutation;
-    apparentLongitude = ESUtil::fmod(apparentLongitude, M_PI * 2);
-    if (apparentLongitude < 0) {
-	apparentLongitude += M_PI * 2;
-    }
-    *declinationReturn = asin(sin(obliquity) * sin(apparentLongitude));
-    *rightAscensionReturn = atan2(cos(obliquity) * sin(apparentLongitude), cos(apparentLongitude));
-    if (*rightAscensionReturn < 0) {
-	*rightAscensionReturn += M_PI * 2;
-    }
-    *apparentLongitudeReturn = apparentLongitude;
+    sunApparentRAAndDecl(longitude, aberration, nutation, cos(obliquity), sin(obliquity),
+			 rightAscensionReturn, declinationReturn, apparentLongitudeReturn);
 }
 
 double WB_sunLongitudeApparent(double       hundredCenturiesSinceEpochTDT,
@@ -1086,23 +1505,32 @@ double WB_sunLongitudeApparent(double       hundredCenturiesSinceEpochTDT,
     return apparentLongitude;
 }
 
-static void WB_convertGeocentric(double hundredCenturiesSinceEpochTDT,
-				 double planetHeliocentricLongitude,
-				 double planetHeliocentricLatitude,
-				 double planetHeliocentricRadius,
-				 double sunMeanLongitude,
-				 double sunMeanRadius,
-				 double planetaryLongitudeAberration,
-				 double planetaryLatitudeAberration,
-				 double obliquity,
-				 double nutation,
-				 double *geocentricApparentLongitude,
-				 double *geocentricApparentLatitude,
-				 double *geocentricDistance,
-				 double *apparentRightAscension,
-				 double *apparentDeclination) {
-    double xSunGeo = sunMeanRadius * cos(sunMeanLongitude);
-    double ySunGeo = sunMeanRadius * sin(sunMeanLongitude);
+void WB_frameForTDT(double       hundredCenturiesSinceEpochTDT,
+		    ECWBFrame    *frame,
+		    ECAstroCache *currentCache) {
+    frame->hundredCenturiesSinceEpochTDT = hundredCenturiesSinceEpochTDT;
+    WB_sunLongitudeRadiusRaw(hundredCenturiesSinceEpochTDT, &frame->sunLongitude, &frame->sunRadius, currentCache);
+    frame->sunLongitudeAberration = WB_sunLongitudeAberration(hundredCenturiesSinceEpochTDT);
+    WB_nutationObliquity(hundredCenturiesSinceEpochTDT, &frame->nutation, &frame->obliquity, currentCache);
+    frame->cosObliquity = cos(frame->obliquity);
+    frame->sinObliquity = sin(frame->obliquity);
+    frame->xSunGeo = frame->sunRadius * cos(frame->sunLongitude);
+    frame->ySunGeo = frame->sunRadius * sin(frame->sunLongitude);
+}
+
+static void WB_convertGeocentric(const ECWBFrame *frame,
+				 double          planetHeliocentricLongitude,
+				 double          planetHeliocentricLatitude,
+				 double          planetHeliocentricRadius,
+				 double          planetaryLongitudeAberration,
+				 double          planetaryLatitudeAberration,
+				 double          *geocentricApparentLongitude,
+				 double          *geocentricApparentLatitude,
+				 double          *geocentricDistance,
+				 double          *apparentRightAscension,
+				 double          *apparentDeclination) {
+    double xSunGeo = frame->xSunGeo;
+    double ySunGeo = frame->ySunGeo;
     const double zSunGeo = 0;
 
     double xPlanetHelio = planetHeliocentricRadius * cos(planetHeliocentricLatitude) * cos(planetHeliocentricLongitude);
@@ -1118,7 +1546,7 @@ static void WB_convertGeocentric(double hundredCenturiesSinceEpochTDT,
     double planetMeanGeoLongitude = atan2(yPlanetGeo, xPlanetGeo);
     double planetMeanGeoLatitude = atan2(zPlanetGeo, sqrt(xPlanetGeo*xPlanetGeo + yPlanetGeo * yPlanetGeo));
 
-    *geocentricApparentLongitude = planetMeanGeoLongitude + planetaryLongitudeAberration + nutation;
+    *geocentricApparentLongitude = planetMeanGeoLongitude + planetaryLongitudeAberration + frame->nutation;
     if (*geocentricApparentLongitude < 0) {
 	*geocentricApparentLongitude += M_PI * 2;
     } else if (*geocentricApparentLongitude > M_PI * 2) {
@@ -1127,8 +1555,8 @@ static void WB_convertGeocentric(double hundredCenturiesSinceEpochTDT,
     *geocentricApparentLatitude = planetMeanGeoLatitude + planetaryLatitudeAberration;
 
     if (apparentDeclination && apparentRightAscension) {
-	double cosObliquity = cos(obliquity);
-	double sinObliquity = sin(obliquity);
+	double cosObliquity = frame->cosObliquity;
+	double sinObliquity = frame->sinObliquity;
 	double sinLatitude = sin(*geocentricApparentLatitude);
 	double cosLatitude = cos(*geocentricApparentLatitude);
 	double sinLongitude = sin(*geocentricApparentLongitude);
@@ -1145,23 +1573,131 @@ static void WB_convertGeocentric(double hundredCenturiesSinceEpochTDT,
     }
 }
 
-/********* MERCURY *********/
+/********* INNER PLANETS *********/
 
-double WB_mercuryHeliocentricLongitude(double hundredCenturiesSinceEpochTDT) {
-    double U = hundredCenturiesSinceEpochTDT;
-    double U_2 = U * U;
-    double U_3 = U * U_2;
-    double U_4 = U_2 * U_2;
-    double U_5 = U * U_4;
-    
-    double L = 0;
-    for (int i = 0; i < numMercuryLongData; i++) {
-	const InnerPlanetDatum *datum = &mercuryLongitudeData[i];
-	L += datum->vi*sin(datum->ai + U*datum->bi);
+// The periodic terms of an inner planet's longitude, latitude, and radius series, rearranged so that all three series
+// are summed in one pass.  Most frequencies appear in only one series; those terms are kept as v*sin(a + b*U) (radius
+// terms are converted from cos by a quarter-turn phase shift).  Where the same frequency appears in more than one series,
+// the terms are expanded by the angle-addition formula so that one sin/cos of b*U serves them all.
+#define INNER_PLANET_LONGITUDE 0
+#define INNER_PLANET_LATITUDE  1
+#define INNER_PLANET_RADIUS    2
+
+typedef struct _InnerPlanetSingleTerm {
+    double vi;
+    double ai;
+    double bi;
+    int    series;  // INNER_PLANET_LONGITUDE, etc.
+} InnerPlanetSingleTerm;
+
+typedef struct _InnerPlanetSharedTerm {
+    double frequency;
+    double sinCoeff[3];  // per series, coefficient of sin(b*U)
+    double cosCoeff[3];  // per series, coefficient of cos(b*U)
+} InnerPlanetSharedTerm;
+
+typedef struct _InnerPlanetTerms {
+    int                   numSingleTerms;
+    InnerPlanetSingleTerm *singleTerms;
+    int                   numSharedTerms;
+    InnerPlanetSharedTerm *sharedTerms;
+} InnerPlanetTerms;
+
+static int
+countInnerPlanetFrequency(const InnerPlanetDescriptor *descriptor,
+			  double                      frequency) {
+    int count = 0;
+    for (int i = 0; i < descriptor->numLongData; i++) {
+	count += descriptor->longitudeData[i].bi == frequency;
     }
-    L = L * 1E-7 + 4.4429839 + 260881.4701279*U +
-	1E-6 * (409894.2 + 2435*U - 1408*U_2 + 114*U_3 + 233*U_4 - 88*U_5)
-	*sin(3.053817 + 260878.756773*U - 0.001093*U_2 - 0.00093*U_3 + 0.00043*U_4 + 0.00014*U_5);
+    for (int i = 0; i < descriptor->numLatData; i++) {
+	count += descriptor->latitudeData[i].bi == frequency;
+    }
+    for (int i = 0; i < descriptor->numRadData; i++) {
+	count += descriptor->radiusData[i].bi == frequency;
+    }
+    return count;
+}
+
+static void
+addInnerPlanetTerm(InnerPlanetTerms            *terms,
+		   const InnerPlanetDescriptor *descriptor,
+		   const InnerPlanetDatum      *datum,
+		   int                         series) {
+    // For radius, v*cos(a + b*U) == v*sin(a + PI/2 + b*U)
+    double phase = series == INNER_PLANET_RADIUS ? datum->ai + M_PI / 2 : datum->ai;
+    if (countInnerPlanetFrequency(descriptor, datum->bi) == 1) {
+	InnerPlanetSingleTerm *term = &terms->singleTerms[terms->numSingleTerms++];
+	term->vi = datum->vi;
+	term->ai = phase;
+	term->bi = datum->bi;
+	term->series = series;
+	return;
+    }
+    InnerPlanetSharedTerm *term = NULL;
+    for (int i = 0; i < terms->numSharedTerms; i++) {
+	if (terms->sharedTerms[i].frequency == datum->bi) {
+	    term = &terms->sharedTerms[i];
+	    break;
+	}
+    }
+    if (!term) {
+	term = &terms->sharedTerms[terms->numSharedTerms++];
+	memset(term, 0, sizeof(InnerPlanetSharedTerm));
+	term->frequency = datum->bi;
+    }
+    term->sinCoeff[series] += datum->vi * cos(phase);
+    term->cosCoeff[series] += datum->vi * sin(phase);
+}
+
+static const InnerPlanetTerms *
+makeInnerPlanetTerms(const InnerPlanetDescriptor *descriptor) {
+    int maxTerms = descriptor->numLongData + descriptor->numLatData + descriptor->numRadData;
+    InnerPlanetTerms *terms = (InnerPlanetTerms *)malloc(sizeof(InnerPlanetTerms));
+    terms->numSingleTerms = 0;
+    terms->singleTerms = (InnerPlanetSingleTerm *)malloc(maxTerms * sizeof(InnerPlanetSingleTerm));
+    terms->numSharedTerms = 0;
+    terms->sharedTerms = (InnerPlanetSharedTerm *)malloc(maxTerms * sizeof(InnerPlanetSharedTerm));
+    for (int i = 0; i < descriptor->numLongData; i++) {
+	addInnerPlanetTerm(terms, descriptor, &descriptor->longitudeData[i], INNER_PLANET_LONGITUDE);
+    }
+    for (int i = 0; i < descriptor->numLatData; i++) {
+	addInnerPlanetTerm(terms, descriptor, &descriptor->latitudeData[i], INNER_PLANET_LATITUDE);
+    }
+    for (int i = 0; i < descriptor->numRadData; i++) {
+	addInnerPlanetTerm(terms, descriptor, &descriptor->radiusData[i], INNER_PLANET_RADIUS);
+    }
+    return terms;
+}
+
+// Returns the raw (unscaled) sums of the periodic terms
+static void
+sumInnerPlanetTerms(const InnerPlanetTerms *terms,
+		    double                 U,
+		    double                 *longitudeSum,
+		    double                 *latitudeSum,
+		    double                 *radiusSum) {
+    double sums[3] = { 0, 0, 0 };
+    for (int i = 0; i < terms->numSingleTerms; i++) {
+	const InnerPlanetSingleTerm *term = &terms->singleTerms[i];
+	sums[term->series] += term->vi * sin(term->ai + U * term->bi);
+    }
+    for (int i = 0; i < terms->numSharedTerms; i++) {
+	const InnerPlanetSharedTerm *term = &terms->sharedTerms[i];
+	double arg = term->frequency * U;
+	double sinArg = sin(arg);
+	double cosArg = cos(arg);
+	for (int series = 0; series < 3; series++) {
+	    sums[series] += term->sinCoeff[series] * sinArg + term->cosCoeff[series] * cosArg;
+	}
+    }
+    *longitudeSum = sums[INNER_PLANET_LONGITUDE];
+    *latitudeSum = sums[INNER_PLANET_LATITUDE];
+    *radiusSum = sums[INNER_PLANET_RADIUS];
+}
+
+static double
+normalizeHeliocentricLongitude(double L) {
     L = ESUtil::fmod(L, M_PI * 2);
     if (L < 0) {
 	L += M_PI * 2;
@@ -1169,31 +1705,62 @@ double WB_mercuryHeliocentricLongitude(double hundredCenturiesSinceEpochTDT) {
     return L;
 }
 
-double WB_mercuryHeliocentricLatitude(double hundredCenturiesSinceEpochTDT) {
-    double U = hundredCenturiesSinceEpochTDT;
-    double L = 0;
-    for (int i = 0; i < numMercuryLatData; i++) {
-	const InnerPlanetDatum *datum = &mercuryLatitudeData[i];
-	L += datum->vi*sin(datum->ai + U*datum->bi);
+// Raw (unscaled) sum of a single series, as the per-quantity accessors used to compute it before the fused evaluation
+static double
+sumInnerPlanetSeries(const InnerPlanetDescriptor *descriptor,
+		     int                         series,
+		     double                      U) {
+    double sum = 0;
+    if (series == INNER_PLANET_LONGITUDE) {
+	for (int i = 0; i < descriptor->numLongData; i++) {
+	    const InnerPlanetDatum *datum = &descriptor->longitudeData[i];
+	    sum += datum->vi*sin(datum->ai + U*datum->bi);
+	}
+    } else if (series == INNER_PLANET_LATITUDE) {
+	for (int i = 0; i < descriptor->numLatData; i++) {
+	    const InnerPlanetDatum *datum = &descriptor->latitudeData[i];
+	    sum += datum->vi*sin(datum->ai + U*datum->bi);
+	}
+    } else {
+	for (int i = 0; i < descriptor->numRadData; i++) {
+	    const InnerPlanetDatum *datum = &descriptor->radiusData[i];
+	    sum += datum->vi*cos(datum->ai + U*datum->bi);
+	}
     }
-    return L * 1E-7;
+    return sum;
 }
 
-double WB_mercuryRadius(double hundredCenturiesSinceEpochTDT) {
-    double U = hundredCenturiesSinceEpochTDT;
-    double R = 0;
-    for (int i = 0; i < numMercuryRadData; i++) {
-	const InnerPlanetDatum *datum = &mercuryRadiusData[i];
-	R += datum->vi*cos(datum->ai + U*datum->bi);
-    }
-    return 0.3952020 + 1E-7*R;
+// The per-planet functions below turn the raw series sums into the heliocentric quantities, so the fused evaluation
+// and the per-quantity accessors share them
+
+static double
+mercuryLongitude(double U,
+		 double longitudeSum) {
+    double U_2 = U * U;
+    double U_3 = U * U_2;
+    double U_4 = U_2 * U_2;
+    double U_5 = U * U_4;
+    double L = longitudeSum * 1E-7 + 4.4429839 + 260881.4701279*U +
+	1E-6 * (409894.2 + 2435*U - 1408*U_2 + 114*U_3 + 233*U_4 - 88*U_5)
+	*sin(3.053817 + 260878.756773*U - 0.001093*U_2 - 0.00093*U_3 + 0.00043*U_4 + 0.00014*U_5);
+    return normalizeHeliocentricLongitude(L);
+}
+
+static double
+mercuryLatitude(double latitudeSum) {
+    return latitudeSum * 1E-7;
+}
+
+static double
+mercuryRadius(double radiusSum) {
+    return 0.3952020 + 1E-7*radiusSum;
 }
 
 double WB_mercuryLongitudeAberration(double hundredCenturiesSinceEpochTDT) {
     double U = hundredCenturiesSinceEpochTDT;
     return 1E-7 * (-1261 + 1485*cos(2.649 + 198048.273*U)
-		    + 305*cos(5.71 + 458927.03*U)
-		    + 230*cos(5.30 + 396096.55*U));
+		   + 305*cos(5.71 + 458927.03*U)
+		   + 230*cos(5.30 + 396096.55*U));
 }
 
 double WB_mercuryLatitudeAberration(double hundredCenturiesSinceEpochTDT) {
@@ -1201,108 +1768,69 @@ double WB_mercuryLatitudeAberration(double hundredCenturiesSinceEpochTDT) {
     return 190E-7 * cos(0.42 + 260879.41*U);
 }
 
-void WB_mercuryApparentPosition(double 	     hundredCenturiesSinceEpochTDT,
-				double 	     *geocentricApparentLongitude,
-				double 	     *geocentricApparentLatitude,
-				double 	     *geocentricDistance,
-				double 	     *apparentRightAscension,
-				double 	     *apparentDeclination,
-				ECAstroCache *currentCache) {
-    double sunMeanLongitude;
-    double sunMeanRadius;
-    WB_sunLongitudeRadiusRaw(hundredCenturiesSinceEpochTDT,
-			     &sunMeanLongitude,
-			     &sunMeanRadius, currentCache);
-    double nutation;
-    double obliquity;
-    WB_nutationObliquity(hundredCenturiesSinceEpochTDT, &nutation, &obliquity, currentCache);
-    WB_convertGeocentric(hundredCenturiesSinceEpochTDT,
-			 WB_mercuryHeliocentricLongitude(hundredCenturiesSinceEpochTDT),
-			 WB_mercuryHeliocentricLatitude(hundredCenturiesSinceEpochTDT),
-			 WB_mercuryRadius(hundredCenturiesSinceEpochTDT),
-			 sunMeanLongitude,
-			 sunMeanRadius,
-			 WB_mercuryLongitudeAberration(hundredCenturiesSinceEpochTDT),
-			 WB_mercuryLatitudeAberration(hundredCenturiesSinceEpochTDT),
-			 obliquity,
-			 nutation,
-			 geocentricApparentLongitude,
-			 geocentricApparentLatitude,
-			 geocentricDistance,
-			 apparentRightAscension,
-			 apparentDeclination);
+static void
+mercuryHeliocentric(double U,
+		    double *helioLongitude,
+		    double *helioLatitude,
+		    double *helioRadius,
+		    double *longitudeAberration,
+		    double *latitudeAberration) {
+    static const InnerPlanetTerms *terms = makeInnerPlanetTerms(&mercuryDescriptor);
+    double L, B, R;
+    sumInnerPlanetTerms(terms, U, &L, &B, &R);
+    *helioLongitude = mercuryLongitude(U, L);
+    *helioLatitude = mercuryLatitude(B);
+    *helioRadius = mercuryRadius(R);
+    *longitudeAberration = WB_mercuryLongitudeAberration(U);
+    *latitudeAberration = WB_mercuryLatitudeAberration(U);
 }
 
-/********* VENUS *********/
-
-double WB_venusHeliocentricLongitude(double hundredCenturiesSinceEpochTDT) {
-    double U = hundredCenturiesSinceEpochTDT;
+static double
+venusLongitude(double U,
+	       double longitudeSum) {
     double U_2 = U * U;
     double U_3 = U * U_2;
     double U_4 = U_2 * U_2;
     double U_5 = U * U_4;
     double U_6 = U_3 * U_3;
-    
-    double L = 0;
-    for (int i = 0; i < numVenusLongData; i++) {
-	const InnerPlanetDatum *datum = &venusLongitudeData[i];
-	L += datum->vi*sin(datum->ai + U*datum->bi);
-    }
-
-    L = L*1E-7 + 3.2184413 + 102135.2937764*U
+    double L = longitudeSum*1E-7 + 3.2184413 + 102135.2937764*U
         + 1E-6*(13539.7 - 9570.0*U + 1987*U_2 + 927*U_3 + 230*U_4 - 51*U_5 + 10*U_6)
 	      *sin(0.88074 + 102132.84648*U + 0.24082*U_2 + 0.1004*U_3 + 0.0355*U_4 - 0.0017*U_5 - 0.0151*U_6)
         + 1E-6*(898.9 + 112.4*U - 170*U_2 + 113*U_3 + 34*U_4 - 79*U_5 + 56*U_6)
 	      *sin(0.5941 + 204267.3130*U + 0.014*U_2 + 0.123*U_3 - 0.146*U_4 + 0.052*U_5);
-    L = ESUtil::fmod(L, M_PI * 2);
-    if (L < 0) {
-	L += M_PI * 2;
-    }
-    return L;
+    return normalizeHeliocentricLongitude(L);
 }
 
-double WB_venusHeliocentricLatitude(double hundredCenturiesSinceEpochTDT) {
-    double U = hundredCenturiesSinceEpochTDT;
+static double
+venusLatitude(double U,
+	      double latitudeSum) {
     double U_2 = U * U;
     double U_3 = U * U_2;
     double U_4 = U_2 * U_2;
-
-    double L = 0;
-    for (int i = 0; i < numVenusLatData; i++) {
-	const InnerPlanetDatum *datum = &venusLatitudeData[i];
-	L += datum->vi*sin(datum->ai + U*datum->bi);
-    }
-    L = L*1E-7
+    return latitudeSum*1E-7
 	+ 1E-7*(4011-2713*U + 490*U_2 + 290*U_3 + 90*U_4)
 	       *sin(2.7182 + 204266.568*U + 0.225*U_2 + 0.102*U_3 + 0.035*U_4)
         + 1E-7*(101 + 26*U - 64*U_2)
 	       *sin(2.66 + 306400.49*U + 0.45*U_2);
-    return L;
 }
 
-double WB_venusRadius(double hundredCenturiesSinceEpochTDT) {
-    double U = hundredCenturiesSinceEpochTDT;
+static double
+venusRadius(double U,
+	    double radiusSum) {
     double U_2 = U * U;
     double U_3 = U * U_2;
     double U_4 = U_2 * U_2;
     double U_5 = U_2 * U_3;
     double U_6 = U_3 * U_3;
-    double R = 0;
-    for (int i = 0; i < numVenusRadData; i++) {
-	const InnerPlanetDatum *datum = &venusRadiusData[i];
-	R += datum->vi*cos(datum->ai + U*datum->bi);
-    }
-    R = R*1E-7 + 0.7235481
+    return radiusSum*1E-7 + 0.7235481
         + 1E-7*(48982-34549*U + 7096*U_2 + 3360*U_3 + 890*U_4-210*U_5)
 	      *cos(4.02152 + 102132.84695*U + 0.2420*U_2 + 0.0994*U_3 + 0.0351*U_4 - 0.0013*U_5 - 0.015*U_6)
         + 1E-7*(166-234*U + 131*U_2)
 	      *cos(4.90 + 204265.69*U + 0.48*U_2 + 0.20*U_3);
-    return R;
 }
 
 double WB_venusLongitudeAberration(double hundredCenturiesSinceEpochTDT) {
     double U = hundredCenturiesSinceEpochTDT;
-
     return 1E-7 * (-1304+1016*cos(1.423+39302.097*U)
 		   +224*cos(2.85+78604.19*U)
 		   +98*cos(4.27+117906.29*U));
@@ -1312,153 +1840,281 @@ double WB_venusLatitudeAberration(double hundredCenturiesSinceEpochTDT) {
     return 0;
 }
 
-void WB_venusApparentPosition(double 	   hundredCenturiesSinceEpochTDT,
-			      double 	   *geocentricApparentLongitude,
-			      double 	   *geocentricApparentLatitude,
-			      double 	   *geocentricDistance,
-			      double 	   *apparentRightAscension,
-			      double 	   *apparentDeclination,
-			      ECAstroCache *currentCache) {
-    double sunMeanLongitude;
-    double sunMeanRadius;
-    WB_sunLongitudeRadiusRaw(hundredCenturiesSinceEpochTDT,
-			     &sunMeanLongitude,
-			     &sunMeanRadius, currentCache);
-    double nutation;
-    double obliquity;
-    WB_nutationObliquity(hundredCenturiesSinceEpochTDT, &nutation, &obliquity, currentCache);
-    WB_convertGeocentric(hundredCenturiesSinceEpochTDT,
-			 WB_venusHeliocentricLongitude(hundredCenturiesSinceEpochTDT),
-			 WB_venusHeliocentricLatitude(hundredCenturiesSinceEpochTDT),
-			 WB_venusRadius(hundredCenturiesSinceEpochTDT),
-			 sunMeanLongitude,
-			 sunMeanRadius,
-			 WB_venusLongitudeAberration(hundredCenturiesSinceEpochTDT),
-			 WB_venusLatitudeAberration(hundredCenturiesSinceEpochTDT),
-			 obliquity,
-			 nutation,
-			 geocentricApparentLongitude,
-			 geocentricApparentLatitude,
-			 geocentricDistance,
-			 apparentRightAscension,
-			 apparentDeclination);
+static void
+venusHeliocentric(double U,
+		  double *helioLongitude,
+		  double *helioLatitude,
+		  double *helioRadius,
+		  double *longitudeAberration,
+		  double *latitudeAberration) {
+    static const InnerPlanetTerms *terms = makeInnerPlanetTerms(&venusDescriptor);
+    double L, B, R;
+    sumInnerPlanetTerms(terms, U, &L, &B, &R);
+    *helioLongitude = venusLongitude(U, L);
+    *helioLatitude = venusLatitude(U, B);
+    *helioRadius = venusRadius(U, R);
+    *longitudeAberration = WB_venusLongitudeAberration(U);
+    *latitudeAberration = 0;
 }
 
-/********* MARS *********/
-
-double WB_marsHeliocentricLongitude(double hundredCenturiesSinceEpochTDT) {
-    double U = hundredCenturiesSinceEpochTDT;
+static double
+marsLongitude(double U,
+	      double longitudeSum) {
     double U_2 = U * U;
     double U_3 = U * U_2;
     double U_4 = U_2 * U_2;
-    double U_5 = U * U_4;
+    double U_5 = U_2 * U_3;
     double U_6 = U_3 * U_3;
-    
-    double L = 0;
-    for (int i = 0; i < numMarsLongData; i++) {
-	const InnerPlanetDatum *datum = &marsLongitudeData[i];
-	L += datum->vi*sin(datum->ai + U*datum->bi);
-    }
-
-    L = L * 1E-7 + 6.2458611 + 33408.5620646*U
+    double L = longitudeSum * 1E-7 + 6.2458611 + 33408.5620646*U
 	+ 1E-6 * (186563.7 + 18135.0*U - 1332*U_2 - 704*U_3 - 65*U_4 - 89*U_5 + 9*U_6)
 	       * sin(0.337967 + 33405.348759*U + 0.031676*U_2 - 0.007354*U_3 + 0.001143*U_4 - 0.00029*U_5 - 0.00010*U_6);
-    L = ESUtil::fmod(L, M_PI * 2);
-    if (L < 0) {
-	L += M_PI * 2;
-    }
-    return L;
+    return normalizeHeliocentricLongitude(L);
 }
 
-double WB_marsHeliocentricLatitude(double hundredCenturiesSinceEpochTDT) {
-    double U = hundredCenturiesSinceEpochTDT;
+static double
+marsLatitude(double U,
+	     double latitudeSum) {
     double U_2 = U * U;
     double U_3 = U * U_2;
     double U_4 = U_2 * U_2;
     double U_5 = U_2 * U_3;
     double U_6 = U_3 * U_3;
     double U_7 = U_3 * U_4;
-
-    double L = 0;
-    for (int i = 0; i < numMarsLatData; i++) {
-	const InnerPlanetDatum *datum = &marsLatitudeData[i];
-	L += datum->vi*sin(datum->ai + U*datum->bi);
-    }
-
-    L = L * 1E-7
+    return latitudeSum * 1E-7
 	+ 1E-7*(319714 - 10277*U + 24272*U_2 - 2420*U_3 - 10850*U_4 + 3880*U_5 + 5310*U_6 - 1050*U_7)
  	      *sin(5.339102 + 33407.21879*U + 0.04800*U_2 - 0.04831*U_3 + 0.01402*U_4 + 0.0290*U_5 - 0.0073*U_6 - 0.0112*U_7)
 	+ 1E-7*(29803 + 1904*U + 1865*U_2 - 60*U_3 - 950*U_4 + 220*U_5 + 270*U_6)
 	      *sin(5.67694 + 66812.5668*U + 0.0803*U_2 - 0.0536*U_3 + 0.0147*U_4 + 0.028*U_5)
 	+ 1E-7*(3137 + 472*U + 111*U_2 + 70*U_3)
 	      *sin(6.0173 + 100217.928*U + 0.093*U_2 - 0.086*U_3 + 0.037*U_4);
-    return L;
 }
 
-double WB_marsRadius(double hundredCenturiesSinceEpochTDT) {
-    double U = hundredCenturiesSinceEpochTDT;
+static double
+marsRadius(double U,
+	   double radiusSum) {
     double U_2 = U * U;
     double U_3 = U * U_2;
     double U_4 = U_2 * U_2;
     double U_5 = U_2 * U_3;
     double U_6 = U_3 * U_3;
-    double R = 0;
-    for (int i = 0; i < numMarsRadData; i++) {
-	const InnerPlanetDatum *datum = &marsRadiusData[i];
-	R += datum->vi*cos(datum->ai + U*datum->bi);
-    }
-    R = R*1E-7 + 1.529856
+    return radiusSum*1E-7 + 1.529856
 	+ 1E-6*(141849.5 + 13651.8*U - 1230*U_2 - 378*U_3 + 187*U_4 - 153*U_5 - 73*U_6)
 	      *cos(3.479698 + 33405.349560*U + 0.030669*U_2 - 0.00909*U_3 + 0.00223*U_4 + 0.00083*U_5 - 0.00048*U_6)
         + 1E-6*(6607.8 + 1272.8*U - 53*U_2 - 46*U_3 + 14*U_4 - 12*U_5 + 99*U_6)
 	      *cos(3.81781 + 66810.6991*U + 0.0613*U_2 - 0.0182*U_3 + 0.0044*U_4 + 0.0012*U_5 + 0.002*U_6);
-    return R;
 }
 
-double WB_marsLongitudeAberration(double hundredCenturiesSinceEpochTDT) {
-    double U = hundredCenturiesSinceEpochTDT;
+double WB_marsLongitudeAberration(double hundredCenturiesSinceEpochTDT) {
+    double U = hundredCenturiesSinceEpochTDT;
+    return 1E-7 * (-1052 + 877*cos(1.834 + 29424.634*U)
+		   + 187*cos(3.67 + 58849.27*U)
+		   + 84*cos(3.49 + 33405.34*U));
+}
+
+double WB_marsLatitudeAberration(double hundredCenturiesSinceEpochTDT) {
+    return 0;
+}
+
+static void
+marsHeliocentric(double U,
+		 double *helioLongitude,
+		 double *helioLatitude,
+		 double *helioRadius,
+		 double *longitudeAberration,
+		 double *latitudeAberration) {
+    static const InnerPlanetTerms *terms = makeInnerPlanetTerms(&marsDescriptor);
+    double L, B, R;
+    sumInnerPlanetTerms(terms, U, &L, &B, &R);
+    *helioLongitude = marsLongitude(U, L);
+    *helioLatitude = marsLatitude(U, B);
+    *helioRadius = marsRadius(U, R);
+    *longitudeAberration = WB_marsLongitudeAberration(U);
+    *latitudeAberration = 0;
+}
+
+// All five heliocentric quantities for Mercury, Venus, or Mars, computed together and cached per instant.  The
+// long/lat/radius slots are the same ones ESAstronomyManager::planetHeliocentric* use.
+static void
+innerPlanetHeliocentric(int          planetNumber,
+			double       hundredCenturiesSinceEpochTDT,
+			ECAstroCache *currentCache,
+			double       *helioLongitude,
+			double       *helioLatitude,
+			double       *helioRadius,
+			double       *longitudeAberration,
+			double       *latitudeAberration) {
+    assertCacheValidForTDTHundredCenturies(currentCache, hundredCenturiesSinceEpochTDT);
+    int longitudeAberrationSlotIndex;
+    switch(planetNumber) {
+      case ECPlanetMercury:
+	longitudeAberrationSlotIndex = WBMercuryLongitudeAberrationSlotIndex;
+	break;
+      case ECPlanetVenus:
+	longitudeAberrationSlotIndex = WBVenusLongitudeAberrationSlotIndex;
+	break;
+      case ECPlanetMars:
+	longitudeAberrationSlotIndex = WBMarsLongitudeAberrationSlotIndex;
+	break;
+      default:
+	assert(0);
+	return;
+    }
+    if (currentCache &&
+	currentCache->cacheSlotValidFlag[planetHeliocentricLongitudeSlotIndex+planetNumber] == currentCache->currentFlag &&
+	currentCache->cacheSlotValidFlag[planetHeliocentricLatitudeSlotIndex+planetNumber] == currentCache->currentFlag &&
+	currentCache->cacheSlotValidFlag[planetHeliocentricRadiusSlotIndex+planetNumber] == currentCache->currentFlag &&
+	currentCache->cacheSlotValidFlag[longitudeAberrationSlotIndex] == currentCache->currentFlag &&
+	(planetNumber != ECPlanetMercury ||
+	 currentCache->cacheSlotValidFlag[WBMercuryLatitudeAberrationSlotIndex] == currentCache->currentFlag)) {
+	*helioLongitude = currentCache->cacheSlots[planetHeliocentricLongitudeSlotIndex+planetNumber];
+	*helioLatitude = currentCache->cacheSlots[planetHeliocentricLatitudeSlotIndex+planetNumber];
+	*helioRadius = currentCache->cacheSlots[planetHeliocentricRadiusSlotIndex+planetNumber];
+	*longitudeAberration = currentCache->cacheSlots[longitudeAberrationSlotIndex];
+	*latitudeAberration = planetNumber == ECPlanetMercury ? currentCache->cacheSlots[WBMercuryLatitudeAberrationSlotIndex] : 0;
+	return;
+    }
+    switch(planetNumber) {
+      case ECPlanetMercury:
+	mercuryHeliocentric(hundredCenturiesSinceEpochTDT, helioLongitude, helioLatitude, helioRadius, longitudeAberration, latitudeAberration);
+	break;
+      case ECPlanetVenus:
+	venusHeliocentric(hundredCenturiesSinceEpochTDT, helioLongitude, helioLatitude, helioRadius, longitudeAberration, latitudeAberration);
+	break;
+      case ECPlanetMars:
+	marsHeliocentric(hundredCenturiesSinceEpochTDT, helioLongitude, helioLatitude, helioRadius, longitudeAberration, latitudeAberration);
+	break;
+    }
+    if (currentCache) {
+	currentCache->cacheSlots[planetHeliocentricLongitudeSlotIndex+planetNumber] = *helioLongitude;
+	currentCache->cacheSlotValidFlag[planetHeliocentricLongitudeSlotIndex+planetNumber] = currentCache->currentFlag;
+	currentCache->cacheSlots[planetHeliocentricLatitudeSlotIndex+planetNumber] = *helioLatitude;
+	currentCache->cacheSlotValidFlag[planetHeliocentricLatitudeSlotIndex+planetNumber] = currentCache->currentFlag;
+	currentCache->cacheSlots[planetHeliocentricRadiusSlotIndex+planetNumber] = *helioRadius;
+	currentCache->cacheSlotValidFlag[planetHeliocentricRadiusSlotIndex+planetNumber] = currentCache->currentFlag;
+	currentCache->cacheSlots[longitudeAberrationSlotIndex] = *longitudeAberration;
+	currentCache->cacheSlotValidFlag[longitudeAberrationSlotIndex] = currentCache->currentFlag;
+	if (planetNumber == ECPlanetMercury) {
+	    currentCache->cacheSlots[WBMercuryLatitudeAberrationSlotIndex] = *latitudeAberration;
+	    currentCache->cacheSlotValidFlag[WBMercuryLatitudeAberrationSlotIndex] = currentCache->currentFlag;
+	}
+    }
+}
+
+static void
+innerPlanetApparentPosition(int             planetNumber,
+			    const ECWBFrame *frame,
+			    double 	    *geocentricApparentLongitude,
+			    double 	    *geocentricApparentLatitude,
+			    double 	    *geocentricDistance,
+			    double 	    *apparentRightAscension,
+			    double 	    *apparentDeclination,
+			    ECAstroCache    *currentCache) {
+    double helioLongitude;
+    double helioLatitude;
+    double helioRadius;
+    double longitudeAberration;
+    double latitudeAberration;
+    innerPlanetHeliocentric(planetNumber, frame->hundredCenturiesSinceEpochTDT, currentCache,
+			    &helioLongitude, &helioLatitude, &helioRadius, &longitudeAberration, &latitudeAberration);
+    WB_convertGeocentric(frame,
+			 helioLongitude,
+			 helioLatitude,
+			 helioRadius,
+			 longitudeAberration,
+			 latitudeAberration,
+			 geocentricApparentLongitude,
+			 geocentricApparentLatitude,
+			 geocentricDistance,
+			 apparentRightAscension,
+			 apparentDeclination);
+}
+
+/********* MERCURY *********/
+
+double WB_mercuryHeliocentricLongitude(double hundredCenturiesSinceEpochTDT) {
+    return mercuryLongitude(hundredCenturiesSinceEpochTDT, sumInnerPlanetSeries(&mercuryDescriptor, INNER_PLANET_LONGITUDE, hundredCenturiesSinceEpochTDT));
+}
+
+double WB_mercuryHeliocentricLatitude(double hundredCenturiesSinceEpochTDT) {
+    return mercuryLatitude(sumInnerPlanetSeries(&mercuryDescriptor, INNER_PLANET_LATITUDE, hundredCenturiesSinceEpochTDT));
+}
+
+double WB_mercuryRadius(double hundredCenturiesSinceEpochTDT) {
+    return mercuryRadius(sumInnerPlanetSeries(&mercuryDescriptor, INNER_PLANET_RADIUS, hundredCenturiesSinceEpochTDT));
+}
+
+void WB_mercuryApparentPosition(double 	     hundredCenturiesSinceEpochTDT,
+			        double 	     *geocentricApparentLongitude,
+			        double 	     *geocentricApparentLatitude,
+			        double 	     *geocentricDistance,
+			        double 	     *apparentRightAscension,
+			        double 	     *apparentDeclination,
+			        ECAstroCache *currentCache) {
+    ECWBFrame frame;
+    WB_frameForTDT(hundredCenturiesSinceEpochTDT, &frame, currentCache);
+    innerPlanetApparentPosition(ECPlanetMercury, &frame,
+				geocentricApparentLongitude, geocentricApparentLatitude, geocentricDistance,
+				apparentRightAscension, apparentDeclination, currentCache);
+}
+
+/********* VENUS *********/
+
+double WB_venusHeliocentricLongitude(double hundredCenturiesSinceEpochTDT) {
+    return venusLongitude(hundredCenturiesSinceEpochTDT, sumInnerPlanetSeries(&venusDescriptor, INNER_PLANET_LONGITUDE, hundredCenturiesSinceEpochTDT));
+}
+
+double WB_venusHeliocentricLatitude(double hundredCenturiesSinceEpochTDT) {
+    return venusLatitude(hundredCenturiesSinceEpochTDT, sumInnerPlanetSeries(&venusDescriptor, INNER_PLANET_LATITUDE, hundredCenturiesSinceEpochTDT));
+}
+
+double WB_venusRadius(double hundredCenturiesSinceEpochTDT) {
+    return venusRadius(hundredCenturiesSinceEpochTDT, sumInnerPlanetSeries(&venusDescriptor, INNER_PLANET_RADIUS, hundredCenturiesSinceEpochTDT));
+}
 
-    return 1E-7 * (-1052 + 877*cos(1.834 + 29424.634*U)
-		   + 187*cos(3.67 + 58849.27*U)
-		   + 84*cos(3.49 + 33405.34*U));
+void WB_venusApparentPosition(double 	     hundredCenturiesSinceEpochTDT,
+			      double 	     *geocentricApparentLongitude,
+			      double 	     *geocentricApparentLatitude,
+			      double 	     *geocentricDistance,
+			      double 	     *apparentRightAscension,
+			      double 	     *apparentDeclination,
+			      ECAstroCache *currentCache) {
+    ECWBFrame frame;
+    WB_frameForTDT(hundredCenturiesSinceEpochTDT, &frame, currentCache);
+    innerPlanetApparentPosition(ECPlanetVenus, &frame,
+				geocentricApparentLongitude, geocentricApparentLatitude, geocentricDistance,
+				apparentRightAscension, apparentDeclination, currentCache);
 }
 
-double WB_marsLatitudeAberration(double hundredCenturiesSinceEpochTDT) {
-    return 0;
+/********* MARS *********/
+
+double WB_marsHeliocentricLongitude(double hundredCenturiesSinceEpochTDT) {
+    return marsLongitude(hundredCenturiesSinceEpochTDT, sumInnerPlanetSeries(&marsDescriptor, INNER_PLANET_LONGITUDE, hundredCenturiesSinceEpochTDT));
+}
+
+double WB_marsHeliocentricLatitude(double hundredCenturiesSinceEpochTDT) {
+    return marsLatitude(hundredCenturiesSinceEpochTDT, sumInnerPlanetSeries(&marsDescriptor, INNER_PLANET_LATITUDE, hundredCenturiesSinceEpochTDT));
+}
+
+double WB_marsRadius(double hundredCenturiesSinceEpochTDT) {
+    return marsRadius(hundredCenturiesSinceEpochTDT, sumInnerPlanetSeries(&marsDescriptor, INNER_PLANET_RADIUS, hundredCenturiesSinceEpochTDT));
 }
 
-void WB_marsApparentPosition(double 	  hundredCenturiesSinceEpochTDT,
-			     double 	  *geocentricApparentLongitude,
-			     double 	  *geocentricApparentLatitude,
-			     double 	  *geocentricDistance,
-			     double 	  *apparentRightAscension,
-			     double 	  *apparentDeclination,
+void WB_marsApparentPosition(double 	     hundredCenturiesSinceEpochTDT,
+			     double 	     *geocentricApparentLongitude,
+			     double 	     *geocentricApparentLatitude,
+			     double 	     *geocentricDistance,
+			     double 	     *apparentRightAscension,
+			     double 	     *apparentDeclination,
 			     ECAstroCache *currentCache) {
-    double sunMeanLongitude;
-    double sunMeanRadius;
-    WB_sunLongitudeRadiusRaw(hundredCenturiesSinceEpochTDT,
-			     &sunMeanLongitude,
-			     &sunMeanRadius, currentCache);
-    double nutation;
-    double obliquity;
-    WB_nutationObliquity(hundredCenturiesSinceEpochTDT, &nutation, &obliquity, currentCache);
-    WB_convertGeocentric(hundredCenturiesSinceEpochTDT,
-			 WB_marsHeliocentricLongitude(hundredCenturiesSinceEpochTDT),
-			 WB_marsHeliocentricLatitude(hundredCenturiesSinceEpochTDT),
-			 WB_marsRadius(hundredCenturiesSinceEpochTDT),
-			 sunMeanLongitude,
-			 sunMeanRadius,
-			 WB_marsLongitudeAberration(hundredCenturiesSinceEpochTDT),
-			 WB_marsLatitudeAberration(hundredCenturiesSinceEpochTDT),
-			 obliquity,
-			 nutation,
-			 geocentricApparentLongitude,
-			 geocentricApparentLatitude,
-			 geocentricDistance,
-			 apparentRightAscension,
-			 apparentDeclination);
+    ECWBFrame frame;
+    WB_frameForTDT(hundredCenturiesSinceEpochTDT, &frame, currentCache);
+    innerPlanetApparentPosition(ECPlanetMars, &frame,
+				geocentricApparentLongitude, geocentricApparentLatitude, geocentricDistance,
+				apparentRightAscension, apparentDeclination, currentCache);
 }
 
+#ifdef STANDALONE
+// The original per-quantity evaluation, kept for comparison in BENCHMARKOUTER
 static double
 calcOuterValue(const double Vs[],
 	       const double coeffs[]) {
@@ -1523,18 +2179,99 @@ findOuterPlanetDatum(double                      hundredCenturiesSinceEpochTDT,
     *V = (jd - tryRange->startJD) / 2000;
     return &descriptor->data[indx];
 }
+#endif  // STANDALONE
 
-/********* JUPITER *********/
+// The half-decade ranges start 1826 or 1827 days apart (1817 across the 1582 calendar reform), so a uniform grid of
+// buckets narrower than that has at most one range start in each bucket.  For each bucket we record the range containing
+// the bucket's start; the range for any jd in the bucket is then either that one or the next.
+#define OUTER_PLANET_BUCKET_DAYS 1024
+
+typedef struct _OuterPlanetIndex {
+    const OuterPlanetDescriptor *descriptor;
+    double                      firstJD;
+    double                      lastJD;
+    int                         numBuckets;
+    unsigned short              *bucketEntries;
+} OuterPlanetIndex;
+
+static const OuterPlanetIndex *
+makeOuterPlanetIndex(const OuterPlanetDescriptor *descriptor) {
+    const OuterPlanetJDRange *jdRanges = descriptor->jdRange;
+    OuterPlanetIndex *index = (OuterPlanetIndex *)malloc(sizeof(OuterPlanetIndex));
+    index->descriptor = descriptor;
+    index->firstJD = jdRanges[0].startJD;
+    index->lastJD = jdRanges[descriptor->numEntries - 1].endJD;
+    index->numBuckets = (int)((index->lastJD - index->firstJD) / OUTER_PLANET_BUCKET_DAYS) + 1;
+    index->bucketEntries = (unsigned short *)malloc(index->numBuckets * sizeof(unsigned short));
+    assert(descriptor->numEntries <= 65535);
+    int entry = 0;
+    for (int bucket = 0; bucket < index->numBuckets; bucket++) {
+	double bucketStartJD = index->firstJD + bucket * (double)OUTER_PLANET_BUCKET_DAYS;
+	while (entry < descriptor->numEntries - 1 && jdRanges[entry + 1].startJD <= bucketStartJD) {
+	    entry++;
+	}
+	assert(entry == descriptor->numEntries - 1 || jdRanges[entry + 1].startJD - bucketStartJD >= 0);
+	index->bucketEntries[bucket] = entry;
+    }
+    return index;
+}
 
-double WB_jupiterHeliocentricLongitude(double hundredCenturiesSinceEpochTDT) {
-    double V;
-    const OuterPlanetDatum *datum = findOuterPlanetDatum(hundredCenturiesSinceEpochTDT, &jupiterDescriptor, &V);
-    if (!datum) {
-	return 0;
+// Function-local statics so the indices are built (once, thread-safely) on first use
+static const OuterPlanetIndex *
+jupiterIndex() {
+    static const OuterPlanetIndex *index = makeOuterPlanetIndex(&jupiterDescriptor);
+    return index;
+}
+
+static const OuterPlanetIndex *
+saturnIndex() {
+    static const OuterPlanetIndex *index = makeOuterPlanetIndex(&saturnDescriptor);
+    return index;
+}
+
+static const OuterPlanetIndex *
+uranusIndex() {
+    static const OuterPlanetIndex *index = makeOuterPlanetIndex(&uranusDescriptor);
+    return index;
+}
+
+static const OuterPlanetIndex *
+neptuneIndex() {
+    static const OuterPlanetIndex *index = makeOuterPlanetIndex(&neptuneDescriptor);
+    return index;
+}
+
+// Find the datum for this time and its polynomial argument V; NULL outside the range of the tables
+static const OuterPlanetDatum *
+findOuterPlanetEntry(const OuterPlanetIndex *index,
+		     double                 hundredCenturiesSinceEpochTDT,
+		     double                 *V) {
+    double jd = hundredCenturiesSinceEpochTDT * 3652500 + 2451545;
+    if (!(jd >= index->firstJD && jd <= index->lastJD)) {  // also catches nan
+	return NULL;
+    }
+    const OuterPlanetDescriptor *descriptor = index->descriptor;
+    int entry = index->bucketEntries[(int)((jd - index->firstJD) / OUTER_PLANET_BUCKET_DAYS)];
+    if (entry < descriptor->numEntries - 1 && jd >= descriptor->jdRange[entry + 1].startJD) {
+	entry++;
+    }
+    assert(jd >= descriptor->jdRange[entry].startJD && jd <= descriptor->jdRange[entry].endJD);
+    *V = (jd - descriptor->jdRange[entry].startJD) / 2000;
+    return &descriptor->data[entry];
+}
+
+static double
+outerPlanetSeries(const double coeffs[],
+		  double       V) {
+    double value = coeffs[6];
+    for (int i = 5; i >= 0; i--) {
+	value = value * V + coeffs[i];
     }
-    double Vs[7];
-    makeVsTable(V, Vs);
-    double L = calcOuterValue(Vs, datum->aLong);
+    return value;
+}
+
+static double
+normalizeOuterPlanetLongitude(double L) {
     L = ESUtil::fmod(L, M_PI * 2);
     if (L < 0) {
 	L += M_PI * 2;
@@ -1542,28 +2279,129 @@ double WB_jupiterHeliocentricLongitude(double hundredCenturiesSinceEpochTDT) {
     return L;
 }
 
-double WB_jupiterHeliocentricLatitude(double hundredCenturiesSinceEpochTDT) {
+// Find the datum for this time and evaluate longitude, latitude, and radius together, with one Horner pass
+// over the three coefficient sets.  Returns false (with zeroes) outside the range of the tables.
+static bool
+outerPlanetHeliocentric(const OuterPlanetIndex *index,
+			double                 hundredCenturiesSinceEpochTDT,
+			double                 *helioLongitude,
+			double                 *helioLatitude,
+			double                 *helioRadius) {
     double V;
-    const OuterPlanetDatum *datum = findOuterPlanetDatum(hundredCenturiesSinceEpochTDT, &jupiterDescriptor, &V);
+    const OuterPlanetDatum *datum = findOuterPlanetEntry(index, hundredCenturiesSinceEpochTDT, &V);
     if (!datum) {
-	return 0;
+	*helioLongitude = 0;
+	*helioLatitude = 0;
+	*helioRadius = 0;
+	return false;
+    }
+    double L = datum->aLong[6];
+    double B = datum->aLat[6];
+    double R = datum->aRad[6];
+    for (int i = 5; i >= 0; i--) {
+	L = L * V + datum->aLong[i];
+	B = B * V + datum->aLat[i];
+	R = R * V + datum->aRad[i];
+    }
+    *helioLongitude = normalizeOuterPlanetLongitude(L);
+    *helioLatitude = B;
+    *helioRadius = R;
+    return true;
+}
+
+static const OuterPlanetIndex *
+outerPlanetIndex(int planetNumber) {
+    switch(planetNumber) {
+      case ECPlanetJupiter:
+	return jupiterIndex();
+      case ECPlanetSaturn:
+	return saturnIndex();
+      case ECPlanetUranus:
+	return uranusIndex();
+      case ECPlanetNeptune:
+	return neptuneIndex();
+      default:
+	assert(0);
+	return NULL;
     }
-    double Vs[7];
-    makeVsTable(V, Vs);
-    double L = calcOuterValue(Vs, datum->aLat);
-    return L;
+}
+
+// The fused evaluation, cached per instant in the same slots ESAstronomyManager::planetHeliocentric* use, so that
+// asking for longitude, latitude, and radius in turn costs one evaluation
+static void
+outerPlanetHeliocentricCached(int          planetNumber,
+			      double       hundredCenturiesSinceEpochTDT,
+			      ECAstroCache *currentCache,
+			      double       *helioLongitude,
+			      double       *helioLatitude,
+			      double       *helioRadius) {
+    assertCacheValidForTDTHundredCenturies(currentCache, hundredCenturiesSinceEpochTDT);
+    if (currentCache &&
+	currentCache->cacheSlotValidFlag[planetHeliocentricLongitudeSlotIndex+planetNumber] == currentCache->currentFlag &&
+	currentCache->cacheSlotValidFlag[planetHeliocentricLatitudeSlotIndex+planetNumber] == currentCache->currentFlag &&
+	currentCache->cacheSlotValidFlag[planetHeliocentricRadiusSlotIndex+planetNumber] == currentCache->currentFlag) {
+	*helioLongitude = currentCache->cacheSlots[planetHeliocentricLongitudeSlotIndex+planetNumber];
+	*helioLatitude = currentCache->cacheSlots[planetHeliocentricLatitudeSlotIndex+planetNumber];
+	*helioRadius = currentCache->cacheSlots[planetHeliocentricRadiusSlotIndex+planetNumber];
+	return;
+    }
+    outerPlanetHeliocentric(outerPlanetIndex(planetNumber), hundredCenturiesSinceEpochTDT, helioLongitude, helioLatitude, helioRadius);
+    if (currentCache) {
+	currentCache->cacheSlots[planetHeliocentricLongitudeSlotIndex+planetNumber] = *helioLongitude;
+	currentCache->cacheSlotValidFlag[planetHeliocentricLongitudeSlotIndex+planetNumber] = currentCache->currentFlag;
+	currentCache->cacheSlots[planetHeliocentricLatitudeSlotIndex+planetNumber] = *helioLatitude;
+	currentCache->cacheSlotValidFlag[planetHeliocentricLatitudeSlotIndex+planetNumber] = currentCache->currentFlag;
+	currentCache->cacheSlots[planetHeliocentricRadiusSlotIndex+planetNumber] = *helioRadius;
+	currentCache->cacheSlotValidFlag[planetHeliocentricRadiusSlotIndex+planetNumber] = currentCache->currentFlag;
+    }
+}
+
+static void
+outerPlanetApparentPosition(int             planetNumber,
+			    double          longitudeAberration,
+			    double          latitudeAberration,
+			    const ECWBFrame *frame,
+			    double          *geocentricApparentLongitude,
+			    double          *geocentricApparentLatitude,
+			    double          *geocentricDistance,
+			    double          *apparentRightAscension,
+			    double          *apparentDeclination,
+			    ECAstroCache    *currentCache) {
+    double helioLongitude;
+    double helioLatitude;
+    double helioRadius;
+    outerPlanetHeliocentricCached(planetNumber, frame->hundredCenturiesSinceEpochTDT, currentCache, &helioLongitude, &helioLatitude, &helioRadius);
+    WB_convertGeocentric(frame,
+			 helioLongitude,
+			 helioLatitude,
+			 helioRadius,
+			 longitudeAberration,
+			 latitudeAberration,
+			 geocentricApparentLongitude,
+			 geocentricApparentLatitude,
+			 geocentricDistance,
+			 apparentRightAscension,
+			 apparentDeclination);
+}
+
+/********* JUPITER *********/
+
+double WB_jupiterHeliocentricLongitude(double hundredCenturiesSinceEpochTDT) {
+    double V;
+    const OuterPlanetDatum *datum = findOuterPlanetEntry(jupiterIndex(), hundredCenturiesSinceEpochTDT, &V);
+    return datum ? normalizeOuterPlanetLongitude(outerPlanetSeries(datum->aLong, V)) : 0;
+}
+
+double WB_jupiterHeliocentricLatitude(double hundredCenturiesSinceEpochTDT) {
+    double V;
+    const OuterPlanetDatum *datum = findOuterPlanetEntry(jupiterIndex(), hundredCenturiesSinceEpochTDT, &V);
+    return datum ? outerPlanetSeries(datum->aLat, V) : 0;
 }
 
 double WB_jupiterRadius(double hundredCenturiesSinceEpochTDT) {
     double V;
-    const OuterPlanetDatum *datum = findOuterPlanetDatum(hundredCenturiesSinceEpochTDT, &jupiterDescriptor, &V);
-    if (!datum) {
-	return 0;
-    }
-    double Vs[7];
-    makeVsTable(V, Vs);
-    double R = calcOuterValue(Vs, datum->aRad);
-    return R;
+    const OuterPlanetDatum *datum = findOuterPlanetEntry(jupiterIndex(), hundredCenturiesSinceEpochTDT, &V);
+    return datum ? outerPlanetSeries(datum->aRad, V) : 0;
 }
 
 double WB_jupiterLongitudeAberration(double hundredCenturiesSinceEpochTDT) {
@@ -1586,71 +2424,34 @@ void WB_jupiterApparentPosition(double 	     hundredCenturiesSinceEpochTDT,
 				double 	     *apparentRightAscension,
 				double 	     *apparentDeclination,
 				ECAstroCache *currentCache) {
-    double sunMeanLongitude;
-    double sunMeanRadius;
-    WB_sunLongitudeRadiusRaw(hundredCenturiesSinceEpochTDT,
-			     &sunMeanLongitude,
-			     &sunMeanRadius, currentCache);
-    double nutation;
-    double obliquity;
-    WB_nutationObliquity(hundredCenturiesSinceEpochTDT, &nutation, &obliquity, currentCache);
-    WB_convertGeocentric(hundredCenturiesSinceEpochTDT,
-			 WB_jupiterHeliocentricLongitude(hundredCenturiesSinceEpochTDT),
-			 WB_jupiterHeliocentricLatitude(hundredCenturiesSinceEpochTDT),
-			 WB_jupiterRadius(hundredCenturiesSinceEpochTDT),
-			 sunMeanLongitude,
-			 sunMeanRadius,
-			 WB_jupiterLongitudeAberration(hundredCenturiesSinceEpochTDT),
-			 WB_jupiterLatitudeAberration(hundredCenturiesSinceEpochTDT),
-			 obliquity,
-			 nutation,
-			 geocentricApparentLongitude,
-			 geocentricApparentLatitude,
-			 geocentricDistance,
-			 apparentRightAscension,
-			 apparentDeclination);
+    ECWBFrame frame;
+    WB_frameForTDT(hundredCenturiesSinceEpochTDT, &frame, currentCache);
+    outerPlanetApparentPosition(ECPlanetJupiter,
+				WB_jupiterLongitudeAberration(hundredCenturiesSinceEpochTDT),
+				WB_jupiterLatitudeAberration(hundredCenturiesSinceEpochTDT),
+				&frame,
+				geocentricApparentLongitude, geocentricApparentLatitude, geocentricDistance,
+				apparentRightAscension, apparentDeclination, currentCache);
 }
 
 /********* SATURN *********/
 
 double WB_saturnHeliocentricLongitude(double hundredCenturiesSinceEpochTDT) {
     double V;
-    const OuterPlanetDatum *datum = findOuterPlanetDatum(hundredCenturiesSinceEpochTDT, &saturnDescriptor, &V);
-    if (!datum) {
-	return 0;
-    }
-    double Vs[7];
-    makeVsTable(V, Vs);
-    double L = calcOuterValue(Vs, datum->aLong);
-    L = ESUtil::fmod(L, M_PI * 2);
-    if (L < 0) {
-	L += M_PI * 2;
-    }
-    return L;
+    const OuterPlanetDatum *datum = findOuterPlanetEntry(saturnIndex(), hundredCenturiesSinceEpochTDT, &V);
+    return datum ? normalizeOuterPlanetLongitude(outerPlanetSeries(datum->aLong, V)) : 0;
 }
 
 double WB_saturnHeliocentricLatitude(double hundredCenturiesSinceEpochTDT) {
     double V;
-    const OuterPlanetDatum *datum = findOuterPlanetDatum(hundredCenturiesSinceEpochTDT, &saturnDescriptor, &V);
-    if (!datum) {
-	return 0;
-    }
-    double Vs[7];
-    makeVsTable(V, Vs);
-    double L = calcOuterValue(Vs, datum->aLat);
-    return L;
+    const OuterPlanetDatum *datum = findOuterPlanetEntry(saturnIndex(), hundredCenturiesSinceEpochTDT, &V);
+    return datum ? outerPlanetSeries(datum->aLat, V) : 0;
 }
 
 double WB_saturnRadius(double hundredCenturiesSinceEpochTDT) {
     double V;
-    const OuterPlanetDatum *datum = findOuterPlanetDatum(hundredCenturiesSinceEpochTDT, &saturnDescriptor, &V);
-    if (!datum) {
-	return 0;
-    }
-    double Vs[7];
-    makeVsTable(V, Vs);
-    double R = calcOuterValue(Vs, datum->aRad);
-    return R;
+    const OuterPlanetDatum *datum = findOuterPlanetEntry(saturnIndex(), hundredCenturiesSinceEpochTDT, &V);
+    return datum ? outerPlanetSeries(datum->aRad, V) : 0;
 }
 
 double WB_saturnLongitudeAberration(double hundredCenturiesSinceEpochTDT) {
@@ -1673,71 +2474,34 @@ void WB_saturnApparentPosition(double 	    hundredCenturiesSinceEpochTDT,
 			       double 	    *apparentRightAscension,
 			       double 	    *apparentDeclination,
 			       ECAstroCache *currentCache) {
-    double sunMeanLongitude;
-    double sunMeanRadius;
-    WB_sunLongitudeRadiusRaw(hundredCenturiesSinceEpochTDT,
-			     &sunMeanLongitude,
-			     &sunMeanRadius, currentCache);
-    double nutation;
-    double obliquity;
-    WB_nutationObliquity(hundredCenturiesSinceEpochTDT, &nutation, &obliquity, currentCache);
-    WB_convertGeocentric(hundredCenturiesSinceEpochTDT,
-			 WB_saturnHeliocentricLongitude(hundredCenturiesSinceEpochTDT),
-			 WB_saturnHeliocentricLatitude(hundredCenturiesSinceEpochTDT),
-			 WB_saturnRadius(hundredCenturiesSinceEpochTDT),
-			 sunMeanLongitude,
-			 sunMeanRadius,
-			 WB_saturnLongitudeAberration(hundredCenturiesSinceEpochTDT),
-			 WB_saturnLatitudeAberration(hundredCenturiesSinceEpochTDT),
-			 obliquity,
-			 nutation,
-			 geocentricApparentLongitude,
-			 geocentricApparentLatitude,
-			 geocentricDistance,
-			 apparentRightAscension,
-			 apparentDeclination);
+    ECWBFrame frame;
+    WB_frameForTDT(hundredCenturiesSinceEpochTDT, &frame, currentCache);
+    outerPlanetApparentPosition(ECPlanetSaturn,
+				WB_saturnLongitudeAberration(hundredCenturiesSinceEpochTDT),
+				WB_saturnLatitudeAberration(hundredCenturiesSinceEpochTDT),
+				&frame,
+				geocentricApparentLongitude, geocentricApparentLatitude, geocentricDistance,
+				apparentRightAscension, apparentDeclination, currentCache);
 }
 
 /********* URANUS *********/
 
 double WB_uranusHeliocentricLongitude(double hundredCenturiesSinceEpochTDT) {
     double V;
-    const OuterPlanetDatum *datum = findOuterPlanetDatum(hundredCenturiesSinceEpochTDT, &uranusDescriptor, &V);
-    if (!datum) {
-	return 0;
-    }
-    double Vs[7];
-    makeVsTable(V, Vs);
-    double L = calcOuterValue(Vs, datum->aLong);
-    L = ESUtil::fmod(L, M_PI * 2);
-    if (L < 0) {
-	L += M_PI * 2;
-    }
-    return L;
+    const OuterPlanetDatum *datum = findOuterPlanetEntry(uranusIndex(), hundredCenturiesSinceEpochTDT, &V);
+    return datum ? normalizeOuterPlanetLongitude(outerPlanetSeries(datum->aLong, V)) : 0;
 }
 
 double WB_uranusHeliocentricLatitude(double hundredCenturiesSinceEpochTDT) {
     double V;
-    const OuterPlanetDatum *datum = findOuterPlanetDatum(hundredCenturiesSinceEpochTDT, &uranusDescriptor, &V);
-    if (!datum) {
-	return 0;
-    }
-    double Vs[7];
-    makeVsTable(V, Vs);
-    double L = calcOuterValue(Vs, datum->aLat);
-    return L;
+    const OuterPlanetDatum *datum = findOuterPlanetEntry(uranusIndex(), hundredCenturiesSinceEpochTDT, &V);
+    return datum ? outerPlanetSeries(datum->aLat, V) : 0;
 }
 
 double WB_uranusRadius(double hundredCenturiesSinceEpochTDT) {
     double V;
-    const OuterPlanetDatum *datum = findOuterPlanetDatum(hundredCenturiesSinceEpochTDT, &uranusDescriptor, &V);
-    if (!datum) {
-	return 0;
-    }
-    double Vs[7];
-    makeVsTable(V, Vs);
-    double R = calcOuterValue(Vs, datum->aRad);
-    return R;
+    const OuterPlanetDatum *datum = findOuterPlanetEntry(uranusIndex(), hundredCenturiesSinceEpochTDT, &V);
+    return datum ? outerPlanetSeries(datum->aRad, V) : 0;
 }
 
 double WB_uranusLongitudeAberration(double hundredCenturiesSinceEpochTDT) {
@@ -1759,71 +2523,34 @@ void WB_uranusApparentPosition(double 	    hundredCenturiesSinceEpochTDT,
 			       double 	    *apparentRightAscension,
 			       double 	    *apparentDeclination,
 			       ECAstroCache *currentCache) {
-    double sunMeanLongitude;
-    double sunMeanRadius;
-    WB_sunLongitudeRadiusRaw(hundredCenturiesSinceEpochTDT,
-			     &sunMeanLongitude,
-			     &sunMeanRadius, currentCache);
-    double nutation;
-    double obliquity;
-    WB_nutationObliquity(hundredCenturiesSinceEpochTDT, &nutation, &obliquity, currentCache);
-    WB_convertGeocentric(hundredCenturiesSinceEpochTDT,
-			 WB_uranusHeliocentricLongitude(hundredCenturiesSinceEpochTDT),
-			 WB_uranusHeliocentricLatitude(hundredCenturiesSinceEpochTDT),
-			 WB_uranusRadius(hundredCenturiesSinceEpochTDT),
-			 sunMeanLongitude,
-			 sunMeanRadius,
-			 WB_uranusLongitudeAberration(hundredCenturiesSinceEpochTDT),
-			 WB_uranusLatitudeAberration(hundredCenturiesSinceEpochTDT),
-			 obliquity,
-			 nutation,
-			 geocentricApparentLongitude,
-			 geocentricApparentLatitude,
-			 geocentricDistance,
-			 apparentRightAscension,
-			 apparentDeclination);
+    ECWBFrame frame;
+    WB_frameForTDT(hundredCenturiesSinceEpochTDT, &frame, currentCache);
+    outerPlanetApparentPosition(ECPlanetUranus,
+				WB_uranusLongitudeAberration(hundredCenturiesSinceEpochTDT),
+				WB_uranusLatitudeAberration(hundredCenturiesSinceEpochTDT),
+				&frame,
+				geocentricApparentLongitude, geocentricApparentLatitude, geocentricDistance,
+				apparentRightAscension, apparentDeclination, currentCache);
 }
 
 /********* NEPTUNE *********/
 
 double WB_neptuneHeliocentricLongitude(double hundredCenturiesSinceEpochTDT) {
     double V;
-    const OuterPlanetDatum *datum = findOuterPlanetDatum(hundredCenturiesSinceEpochTDT, &neptuneDescriptor, &V);
-    if (!datum) {
-	return 0;
-    }
-    double Vs[7];
-    makeVsTable(V, Vs);
-    double L = calcOuterValue(Vs, datum->aLong);
-    L = ESUtil::fmod(L, M_PI * 2);
-    if (L < 0) {
-	L += M_PI * 2;
-    }
-    return L;
+    const OuterPlanetDatum *datum = findOuterPlanetEntry(neptuneIndex(), hundredCenturiesSinceEpochTDT, &V);
+    return datum ? normalizeOuterPlanetLongitude(outerPlanetSeries(datum->aLong, V)) : 0;
 }
 
 double WB_neptuneHeliocentricLatitude(double hundredCenturiesSinceEpochTDT) {
     double V;
-    const OuterPlanetDatum *datum = findOuterPlanetDatum(hundredCenturiesSinceEpochTDT, &neptuneDescriptor, &V);
-    if (!datum) {
-	return 0;
-    }
-    double Vs[7];
-    makeVsTable(V, Vs);
-    double L = calcOuterValue(Vs, datum->aLat);
-    return L;
+    const OuterPlanetDatum *datum = findOuterPlanetEntry(neptuneIndex(), hundredCenturiesSinceEpochTDT, &V);
+    return datum ? outerPlanetSeries(datum->aLat, V) : 0;
 }
 
 double WB_neptuneRadius(double hundredCenturiesSinceEpochTDT) {
     double V;
-    const OuterPlanetDatum *datum = findOuterPlanetDatum(hundredCenturiesSinceEpochTDT, &neptuneDescriptor, &V);
-    if (!datum) {
-	return 0;
-    }
-    double Vs[7];
-    makeVsTable(V, Vs);
-    double R = calcOuterValue(Vs, datum->aRad);
-    return R;
+    const OuterPlanetDatum *datum = findOuterPlanetEntry(neptuneIndex(), hundredCenturiesSinceEpochTDT, &V);
+    return datum ? outerPlanetSeries(datum->aRad, V) : 0;
 }
 
 double WB_neptuneLongitudeAberration(double hundredCenturiesSinceEpochTDT) {
@@ -1843,72 +2570,76 @@ void WB_neptuneApparentPosition(double 	     hundredCenturiesSinceEpochTDT,
 				double 	     *apparentRightAscension,
 				double 	     *apparentDeclination,
 				ECAstroCache *currentCache) {
-    double sunMeanLongitude;
-    double sunMeanRadius;
-    WB_sunLongitudeRadiusRaw(hundredCenturiesSinceEpochTDT,
-			     &sunMeanLongitude,
-			     &sunMeanRadius, currentCache);
-    double nutation;
-    double obliquity;
-    WB_nutationObliquity(hundredCenturiesSinceEpochTDT, &nutation, &obliquity, currentCache);
-    WB_convertGeocentric(hundredCenturiesSinceEpochTDT,
-			 WB_neptuneHeliocentricLongitude(hundredCenturiesSinceEpochTDT),
-			 WB_neptuneHeliocentricLatitude(hundredCenturiesSinceEpochTDT),
-			 WB_neptuneRadius(hundredCenturiesSinceEpochTDT),
-			 sunMeanLongitude,
-			 sunMeanRadius,
-			 WB_neptuneLongitudeAberration(hundredCenturiesSinceEpochTDT),
-			 WB_neptuneLatitudeAberration(hundredCenturiesSinceEpochTDT),
-			 obliquity,
-			 nutation,
-			 geocentricApparentLongitude,
-			 geocentricApparentLatitude,
-			 geocentricDistance,
-			 apparentRightAscension,
-			 apparentDeclination);
+    ECWBFrame frame;
+    WB_frameForTDT(hundredCenturiesSinceEpochTDT, &frame, currentCache);
+    outerPlanetApparentPosition(ECPlanetNeptune,
+				WB_neptuneLongitudeAberration(hundredCenturiesSinceEpochTDT),
+				WB_neptuneLatitudeAberration(hundredCenturiesSinceEpochTDT),
+				&frame,
+				geocentricApparentLongitude, geocentricApparentLatitude, geocentricDistance,
+				apparentRightAscension, apparentDeclination, currentCache);
 }
 
 // ***** Generic routines *****
 
-void WB_planetApparentPosition(int    	     planetNumber,
-			       double 	     hundredCenturiesSinceEpochTDT,
-			       double 	     *geocentricApparentLongitude,
-			       double 	     *geocentricApparentLatitude,
-			       double 	     *geocentricDistance, // In AU
-			       double 	     *apparentRightAscension,
-			       double 	     *apparentDeclination,
-			       ECAstroCache  *currentCache,
-			       ECWBPrecision moonPrecision) {
+// The Moon doesn't use the frame:  its series come with their own nutation
+static void moonApparentPosition(double 	hundredCenturiesSinceEpochTDT,
+				 double 	*geocentricApparentLongitude,
+				 double 	*geocentricApparentLatitude,
+				 double 	*geocentricDistance, // In AU
+				 double 	*apparentRightAscension,
+				 double 	*apparentDeclination,
+				 ECAstroCache  *currentCache,
+				 ECWBPrecision moonPrecision) {
+    WB_MoonRAAndDecl(hundredCenturiesSinceEpochTDT*100, apparentRightAscension, apparentDeclination, geocentricApparentLongitude, geocentricApparentLatitude, currentCache, moonPrecision);
+    *geocentricDistance = WB_MoonDistance(hundredCenturiesSinceEpochTDT*100, currentCache, moonPrecision) / kECAUInKilometers;
+}
+
+void WB_planetApparentPositionInFrame(int    	      planetNumber,
+				      const ECWBFrame *frame,
+				      double 	      *geocentricApparentLongitude,
+				      double 	      *geocentricApparentLatitude,
+				      double 	      *geocentricDistance, // In AU
+				      double 	      *apparentRightAscension,
+				      double 	      *apparentDeclination,
+				      ECAstroCache    *currentCache,
+				      ECWBPrecision   moonPrecision) {
+    double U = frame->hundredCenturiesSinceEpochTDT;
     switch(planetNumber) {
       case ECPlanetSun:
-	WB_sunRAAndDecl(hundredCenturiesSinceEpochTDT, apparentRightAscension, apparentDeclination, geocentricApparentLongitude, currentCache);
+	sunApparentRAAndDecl(frame->sunLongitude, frame->sunLongitudeAberration, frame->nutation,
+			     frame->cosObliquity, frame->sinObliquity,
+			     apparentRightAscension, apparentDeclination, geocentricApparentLongitude);
 	*geocentricApparentLatitude = 0;
-	*geocentricDistance = WB_sunRadius(hundredCenturiesSinceEpochTDT, currentCache);
+	*geocentricDistance = frame->sunRadius;
 	return;
       case ECPlanetMoon:
-	WB_MoonRAAndDecl(hundredCenturiesSinceEpochTDT*100, apparentRightAscension, apparentDeclination, geocentricApparentLongitude, geocentricApparentLatitude, currentCache, moonPrecision);
-	*geocentricDistance = WB_MoonDistance(hundredCenturiesSinceEpochTDT*100, currentCache, moonPrecision) / kECAUInKilometers;
+	moonApparentPosition(U, geocentricApparentLongitude, geocentricApparentLatitude, geocentricDistance, apparentRightAscension, apparentDeclination, currentCache, moonPrecision);
 	return;
       case ECPlanetMercury:
-	WB_mercuryApparentPosition(hundredCenturiesSinceEpochTDT, geocentricApparentLongitude, geocentricApparentLatitude, geocentricDistance, apparentRightAscension, apparentDeclination, currentCache);
-	return;
       case ECPlanetVenus:
-	WB_venusApparentPosition(hundredCenturiesSinceEpochTDT, geocentricApparentLongitude, geocentricApparentLatitude, geocentricDistance, apparentRightAscension, apparentDeclination, currentCache);
-	return;
       case ECPlanetMars:
-	WB_marsApparentPosition(hundredCenturiesSinceEpochTDT, geocentricApparentLongitude, geocentricApparentLatitude, geocentricDistance, apparentRightAscension, apparentDeclination, currentCache);
+	innerPlanetApparentPosition(planetNumber, frame, geocentricApparentLongitude, geocentricApparentLatitude, geocentricDistance, apparentRightAscension, apparentDeclination, currentCache);
 	return;
       case ECPlanetJupiter:
-	WB_jupiterApparentPosition(hundredCenturiesSinceEpochTDT, geocentricApparentLongitude, geocentricApparentLatitude, geocentricDistance, apparentRightAscension, apparentDeclination, currentCache);
+	outerPlanetApparentPosition(ECPlanetJupiter, WB_jupiterLongitudeAberration(U), WB_jupiterLatitudeAberration(U), frame,
+				    geocentricApparentLongitude, geocentricApparentLatitude, geocentricDistance, apparentRightAscension, apparentDeclination,
+				    currentCache);
 	return;
       case ECPlanetSaturn:
-	WB_saturnApparentPosition(hundredCenturiesSinceEpochTDT, geocentricApparentLongitude, geocentricApparentLatitude, geocentricDistance, apparentRightAscension, apparentDeclination, currentCache);
+	outerPlanetApparentPosition(ECPlanetSaturn, WB_saturnLongitudeAberration(U), WB_saturnLatitudeAberration(U), frame,
+				    geocentricApparentLongitude, geocentricApparentLatitude, geocentricDistance, apparentRightAscension, apparentDeclination,
+				    currentCache);
 	return;
       case ECPlanetUranus:
-	WB_uranusApparentPosition(hundredCenturiesSinceEpochTDT, geocentricApparentLongitude, geocentricApparentLatitude, geocentricDistance, apparentRightAscension, apparentDeclination, currentCache);
+	outerPlanetApparentPosition(ECPlanetUranus, WB_uranusLongitudeAberration(U), WB_uranusLatitudeAberration(U), frame,
+				    geocentricApparentLongitude, geocentricApparentLatitude, geocentricDistance, apparentRightAscension, apparentDeclination,
+				    currentCache);
 	return;
       case ECPlanetNeptune:
-	WB_neptuneApparentPosition(hundredCenturiesSinceEpochTDT, geocentricApparentLongitude, geocentricApparentLatitude, geocentricDistance, apparentRightAscension, apparentDeclination, currentCache);
+	outerPlanetApparentPosition(ECPlanetNeptune, WB_neptuneLongitudeAberration(U), WB_neptuneLatitudeAberration(U), frame,
+				    geocentricApparentLongitude, geocentricApparentLatitude, geocentricDistance, apparentRightAscension, apparentDeclination,
+				    currentCache);
 	return;
       case ECPlanetPluto:
 	assert(0);
@@ -1925,6 +2656,51 @@ void WB_planetApparentPosition(int    	     planetNumber,
     *apparentDeclination = nan("");
 }
 
+void WB_planetApparentPosition(int    	     planetNumber,
+			       double 	     hundredCenturiesSinceEpochTDT,
+			       double 	     *geocentricApparentLongitude,
+			       double 	     *geocentricApparentLatitude,
+			       double 	     *geocentricDistance, // In AU
+			       double 	     *apparentRightAscension,
+			       double 	     *apparentDeclination,
+			       ECAstroCache  *currentCache,
+			       ECWBPrecision moonPrecision) {
+    if (planetNumber == ECPlanetMoon) {
+	moonApparentPosition(hundredCenturiesSinceEpochTDT, geocentricApparentLongitude, geocentricApparentLatitude, geocentricDistance, apparentRightAscension, apparentDeclination, currentCache, moonPrecision);
+	return;
+    }
+    ECWBFrame frame;
+    WB_frameForTDT(hundredCenturiesSinceEpochTDT, &frame, currentCache);
+    WB_planetApparentPositionInFrame(planetNumber, &frame, geocentricApparentLongitude, geocentricApparentLatitude, geocentricDistance, apparentRightAscension, apparentDeclination, currentCache, moonPrecision);
+}
+
+void WB_allPlanetsApparentPosition(double 	       hundredCenturiesSinceEpochTDT,
+				   unsigned int        planetMask,
+				   ECWBApparentPosition *positions,
+				   ECAstroCache        *currentCache,
+				   ECWBPrecision       moonPrecision) {
+    assert(!(planetMask & ~ECWBAllPlanetsMask));
+    ECWBFrame frame;
+    if (planetMask & ~ECWBPlanetMask(ECPlanetMoon)) {
+	WB_frameForTDT(hundredCenturiesSinceEpochTDT, &frame, currentCache);
+    }
+    for (int planetNumber = ECPlanetSun; planetNumber <= ECLastLegalPlanet; planetNumber++) {
+	if (!(planetMask & ECWBPlanetMask(planetNumber))) {
+	    continue;
+	}
+	ECWBApparentPosition *position = &positions[planetNumber];
+	if (planetNumber == ECPlanetMoon) {
+	    moonApparentPosition(hundredCenturiesSinceEpochTDT,
+				 &position->geocentricApparentLongitude, &position->geocentricApparentLatitude, &position->geocentricDistance,
+				 &position->apparentRightAscension, &position->apparentDeclination, currentCache, moonPrecision);
+	} else {
+	    WB_planetApparentPositionInFrame(planetNumber, &frame,
+					     &position->geocentricApparentLongitude, &position->geocentricApparentLatitude, &position->geocentricDistance,
+					     &position->apparentRightAscension, &position->apparentDeclination, currentCache, moonPrecision);
+	}
+    }
+}
+
 double WB_planetHeliocentricLongitude(int    	   planetNumber,
 				      double 	   hundredCenturiesSinceEpochTDT,
 				      ECAstroCache *currentCache) {
@@ -1939,19 +2715,22 @@ double WB_planetHeliocentricLongitude(int    	   planetNumber,
 	    return helioLong;
 	}
       case ECPlanetMercury:
-	return WB_mercuryHeliocentricLongitude(hundredCenturiesSinceEpochTDT);
       case ECPlanetVenus:
-	return WB_venusHeliocentricLongitude(hundredCenturiesSinceEpochTDT);
       case ECPlanetMars:
-	return WB_marsHeliocentricLongitude(hundredCenturiesSinceEpochTDT);
+	{
+	    double L, B, R, longitudeAberration, latitudeAberration;
+	    innerPlanetHeliocentric(planetNumber, hundredCenturiesSinceEpochTDT, currentCache, &L, &B, &R, &longitudeAberration, &latitudeAberration);
+	    return L;
+	}
       case ECPlanetJupiter:
-	return WB_jupiterHeliocentricLongitude(hundredCenturiesSinceEpochTDT);
       case ECPlanetSaturn:
-	return WB_saturnHeliocentricLongitude(hundredCenturiesSinceEpochTDT);
       case ECPlanetUranus:
-	return WB_uranusHeliocentricLongitude(hundredCenturiesSinceEpochTDT);
       case ECPlanetNeptune:
-	return WB_neptuneHeliocentricLongitude(hundredCenturiesSinceEpochTDT);
+	{
+	    double L, B, R;
+	    outerPlanetHeliocentricCached(planetNumber, hundredCenturiesSinceEpochTDT, currentCache, &L, &B, &R);
+	    return L;
+	}
       case ECPlanetSun:
       case ECPlanetMoon:
       case ECPlanetPluto:
@@ -1970,19 +2749,22 @@ double WB_planetHeliocentricLatitude(int    	  planetNumber,
       case ECPlanetEarth:
 	return 0;
       case ECPlanetMercury:
-	return WB_mercuryHeliocentricLatitude(hundredCenturiesSinceEpochTDT);
       case ECPlanetVenus:
-	return WB_venusHeliocentricLatitude(hundredCenturiesSinceEpochTDT);
       case ECPlanetMars:
-	return WB_marsHeliocentricLatitude(hundredCenturiesSinceEpochTDT);
+	{
+	    double L, B, R, longitudeAberration, latitudeAberration;
+	    innerPlanetHeliocentric(planetNumber, hundredCenturiesSinceEpochTDT, currentCache, &L, &B, &R, &longitudeAberration, &latitudeAberration);
+	    return B;
+	}
       case ECPlanetJupiter:
-	return WB_jupiterHeliocentricLatitude(hundredCenturiesSinceEpochTDT);
       case ECPlanetSaturn:
-	return WB_saturnHeliocentricLatitude(hundredCenturiesSinceEpochTDT);
       case ECPlanetUranus:
-	return WB_uranusHeliocentricLatitude(hundredCenturiesSinceEpochTDT);
       case ECPlanetNeptune:
-	return WB_neptuneHeliocentricLatitude(hundredCenturiesSinceEpochTDT);
+	{
+	    double L, B, R;
+	    outerPlanetHeliocentricCached(planetNumber, hundredCenturiesSinceEpochTDT, currentCache, &L, &B, &R);
+	    return B;
+	}
       case ECPlanetSun:
       case ECPlanetMoon:
       case ECPlanetPluto:
@@ -2001,19 +2783,22 @@ double WB_planetHeliocentricRadius(int    	planetNumber,
       case ECPlanetEarth:
 	return WB_sunRadius(hundredCenturiesSinceEpochTDT, currentCache);
       case ECPlanetMercury:
-	return WB_mercuryRadius(hundredCenturiesSinceEpochTDT);
       case ECPlanetVenus:
-	return WB_venusRadius(hundredCenturiesSinceEpochTDT);
       case ECPlanetMars:
-	return WB_marsRadius(hundredCenturiesSinceEpochTDT);
+	{
+	    double L, B, R, longitudeAberration, latitudeAberration;
+	    innerPlanetHeliocentric(planetNumber, hundredCenturiesSinceEpochTDT, currentCache, &L, &B, &R, &longitudeAberration, &latitudeAberration);
+	    return R;
+	}
       case ECPlanetJupiter:
-	return WB_jupiterRadius(hundredCenturiesSinceEpochTDT);
       case ECPlanetSaturn:
-	return WB_saturnRadius(hundredCenturiesSinceEpochTDT);
       case ECPlanetUranus:
-	return WB_uranusRadius(hundredCenturiesSinceEpochTDT);
       case ECPlanetNeptune:
-	return WB_neptuneRadius(hundredCenturiesSinceEpochTDT);
+	{
+	    double L, B, R;
+	    outerPlanetHeliocentricCached(planetNumber, hundredCenturiesSinceEpochTDT, currentCache, &L, &B, &R);
+	    return R;
+	}
       case ECPlanetSun:
       case ECPlanetMoon:
       case ECPlanetPluto:
@@ -2600,6 +3385,301 @@ static void EXAMPLEP() {
     EXAMPLEPx(TDTForUTDate(2009, 5, 3, 20, 0, 0), "EXAMPLEP NOW");
 }
 
+// Compare the bucketed lookup and fused evaluation against the original per-quantity path, at every range boundary
+// and across the whole table, and time both
+static void BENCHMARKOUTER1(const char                  *planetName,
+			    const OuterPlanetDescriptor *descriptor,
+			    const OuterPlanetIndex      *index) {
+    double maxErr = 0;
+    int mismatches = 0;
+    for (int i = 0; i < descriptor->numEntries; i++) {
+	double jds[3] = { descriptor->jdRange[i].startJD, descriptor->jdRange[i].startJD + 913.25, descriptor->jdRange[i].endJD };
+	for (int j = 0; j < 3; j++) {
+	    double U = (jds[j] - 2451545) / 3652500;
+	    double V;
+	    const OuterPlanetDatum *datum = findOuterPlanetDatum(U, descriptor, &V);
+	    double L, B, R;
+	    bool ok = outerPlanetHeliocentric(index, U, &L, &B, &R);
+	    if (!datum || !ok) {
+		mismatches++;
+		continue;
+	    }
+	    double Vs[7];
+	    makeVsTable(V, Vs);
+	    double oldL = ESUtil::fmod(calcOuterValue(Vs, datum->aLong), M_PI * 2);
+	    double err = fabs(remainder(oldL - L, M_PI * 2));
+	    err = fmax(err, fabs(calcOuterValue(Vs, datum->aLat) - B));
+	    err = fmax(err, fabs(calcOuterValue(Vs, datum->aRad) - R));
+	    if (err > maxErr) {
+		maxErr = err;
+	    }
+	}
+    }
+    // Time one quantity (longitude) and all three (as three per-quantity calls before, one fused call now)
+    const int numSamples = 2000000;
+    double firstJD = descriptor->jdRange[0].startJD;
+    double lastJD = descriptor->jdRange[descriptor->numEntries - 1].endJD;
+    double step = (lastJD - firstJD) / numSamples;
+    double oldSum = 0;
+    double newSum = 0;
+    double seconds[4];
+    for (int pass = 0; pass < 4; pass++) {
+	clock_t startClock = clock();
+	for (int i = 0; i < numSamples; i++) {
+	    double U = (firstJD + i * step - 2451545) / 3652500;
+	    if (pass == 0 || pass == 2) {
+		for (int q = 0; q < (pass == 0 ? 1 : 3); q++) {
+		    double V;
+		    const OuterPlanetDatum *datum = findOuterPlanetDatum(U, descriptor, &V);
+		    double Vs[7];
+		    makeVsTable(V, Vs);
+		    oldSum += q == 0 ? ESUtil::fmod(calcOuterValue(Vs, datum->aLong), M_PI * 2) : calcOuterValue(Vs, q == 1 ? datum->aLat : datum->aRad);
+		}
+	    } else if (pass == 1) {
+		double V;
+		const OuterPlanetDatum *datum = findOuterPlanetEntry(index, U, &V);
+		newSum += normalizeOuterPlanetLongitude(outerPlanetSeries(datum->aLong, V));
+	    } else {
+		double L, B, R;
+		outerPlanetHeliocentric(index, U, &L, &B, &R);
+		newSum += L + B + R;
+	    }
+	}
+	seconds[pass] = (double)(clock() - startClock) / CLOCKS_PER_SEC;
+    }
+    printf("BENCHMARKOUTER:%-8s %s maxErr %.3g, one quantity old %.1f ns new %.1f ns, L/B/R old %.1f ns new %.1f ns (%g %g)\n",
+	   planetName, (mismatches == 0 && maxErr < 1e-12) ? "ok  " : "FAIL", maxErr,
+	   seconds[0] * 1e9 / numSamples, seconds[1] * 1e9 / numSamples, seconds[2] * 1e9 / numSamples, seconds[3] * 1e9 / numSamples,
+	   oldSum, newSum);
+}
+
+// Compare one WB_allPlanetsApparentPosition call against an individual WB_planetApparentPosition call per body, uncached
+static void BENCHMARKALLPLANETS() {
+    const int numSamples = 20000;
+    double maxErr = 0;
+    double individualSum = 0;
+    double allSum = 0;
+    double individualSeconds = 0;
+    double allSeconds = 0;
+    for (int i = 0; i < numSamples; i++) {
+	double U = -0.2 + 0.4 * i / numSamples;
+	ECWBApparentPosition individual[ECLastLegalPlanet + 1];
+	ECWBApparentPosition all[ECLastLegalPlanet + 1];
+	clock_t startClock = clock();
+	for (int planetNumber = ECPlanetSun; planetNumber <= ECLastLegalPlanet; planetNumber++) {
+	    if (ECWBAllPlanetsMask & ECWBPlanetMask(planetNumber)) {
+		ECWBApparentPosition *position = &individual[planetNumber];
+		WB_planetApparentPosition(planetNumber, U,
+					  &position->geocentricApparentLongitude, &position->geocentricApparentLatitude, &position->geocentricDistance,
+					  &position->apparentRightAscension, &position->apparentDeclination, NULL, ECWBFullPrecision);
+	    }
+	}
+	individualSeconds += (double)(clock() - startClock) / CLOCKS_PER_SEC;
+	startClock = clock();
+	WB_allPlanetsApparentPosition(U, ECWBAllPlanetsMask, all, NULL, ECWBFullPrecision);
+	allSeconds += (double)(clock() - startClock) / CLOCKS_PER_SEC;
+	for (int planetNumber = ECPlanetSun; planetNumber <= ECLastLegalPlanet; planetNumber++) {
+	    if (ECWBAllPlanetsMask & ECWBPlanetMask(planetNumber)) {
+		const double *a = &individual[planetNumber].geocentricApparentLongitude;
+		const double *b = &all[planetNumber].geocentricApparentLongitude;
+		for (int j = 0; j < 5; j++) {
+		    maxErr = fmax(maxErr, fabs(a[j] - b[j]));
+		    individualSum += a[j];
+		    allSum += b[j];
+		}
+	    }
+	}
+    }
+    printf("BENCHMARKALLPLANETS: %s maxErr %.3g, individual %.0f ns, all %.0f ns (%g %g)\n",
+	   maxErr == 0 ? "ok  " : "FAIL", maxErr,
+	   individualSeconds * 1e9 / numSamples, allSeconds * 1e9 / numSamples, individualSum, allSum);
+}
+
+// The search ESWBLunarMultiples.h was generated with.  Finds the combination of the fundamental arguments (only their first numCoefficients coefficients) closest to the
+// given argument, and replaces coefficients[] with the residual.  Returns false, leaving coefficients[] alone, if no
+// combination of multiples up to LUNAR_MAX_MULTIPLE keeps the non-constant part of the residual under
+// LUNAR_MAX_RESIDUAL over the era.
+static bool
+searchLunarArgumentMultiples(double      coefficients[5],
+			     int         numCoefficients,
+			     signed char multiples[LUNAR_NUM_ARGUMENTS]) {
+    double fundamental[LUNAR_NUM_ARGUMENTS][5];
+    lunarFundamentalArgumentsInRadians(fundamental);
+    double bestResidual[5];
+    double bestError = LUNAR_MAX_RESIDUAL;
+    bool found = false;
+    for (int i = -LUNAR_MAX_MULTIPLE; i <= LUNAR_MAX_MULTIPLE; i++) {
+	for (int j = -LUNAR_MAX_MULTIPLE; j <= LUNAR_MAX_MULTIPLE; j++) {
+	    for (int k = -LUNAR_MAX_MULTIPLE; k <= LUNAR_MAX_MULTIPLE; k++) {
+		// The rate determines the last multiple
+		double rate = coefficients[1] - i * fundamental[0][1] - j * fundamental[1][1] - k * fundamental[2][1];
+		int m = (int)floor(rate / fundamental[3][1] + 0.5);
+		if (m < -LUNAR_MAX_MULTIPLE || m > LUNAR_MAX_MULTIPLE) {
+		    continue;
+		}
+		const int n[LUNAR_NUM_ARGUMENTS] = { i, j, k, m };
+		double residual[5];
+		for (int c = 0; c < numCoefficients; c++) {
+		    residual[c] = coefficients[c];
+		    for (int a = 0; a < LUNAR_NUM_ARGUMENTS; a++) {
+			residual[c] -= n[a] * fundamental[a][c];
+		    }
+		}
+		double error = 0;
+		for (double t = -LUNAR_RESIDUAL_ERA; t <= LUNAR_RESIDUAL_ERA; t += 2 * LUNAR_RESIDUAL_ERA) {
+		    double value = 0;
+		    for (int c = numCoefficients - 1; c > 0; c--) {
+			value = (value + residual[c]) * t;
+		    }
+		    if (fabs(value) > error) {
+			error = fabs(value);
+		    }
+		}
+		if (error < bestError) {
+		    bestError = error;
+		    found = true;
+		    for (int a = 0; a < LUNAR_NUM_ARGUMENTS; a++) {
+			multiples[a] = (signed char)n[a];
+		    }
+		    for (int c = 0; c < numCoefficients; c++) {
+			bestResidual[c] = residual[c];
+		    }
+		}
+	    }
+	}
+    }
+    if (found) {
+	for (int c = 0; c < numCoefficients; c++) {
+	    coefficients[c] = bestResidual[c];
+	}
+    }
+    return found;
+}
+
+// Checks ESWBLunarMultiples.h against the search it was generated by, and reports what the search would cost at
+// startup, how many terms have no combination (and so cost a sine of their own), and how many of the decomposed terms
+// need a cos and sin of their residual at various distances from the epoch
+template <class TermType>
+static void
+countLunarResidualFallbacks(const TermType *terms,
+			    int            numTerms,
+			    int            numCoefficients,
+			    double         t,
+			    int            *numDecomposed,
+			    int            *numFallbacks) {
+    for (int i = 0; i < numTerms; i++) {
+	if (terms[i].decomposed) {
+	    const double *c = &terms[i].c0;
+	    double residual = 0;
+	    for (int j = numCoefficients - 1; j > 0; j--) {
+		residual = (residual + c[j]) * t;
+	    }
+	    (*numDecomposed)++;
+	    if (fabs(residual) >= LUNAR_SMALL_RESIDUAL) {
+		(*numFallbacks)++;
+	    }
+	}
+    }
+}
+
+static void
+checkLunarMultiples(const double      a[5],
+		    int               numCoefficients,
+		    const signed char expected[LUNAR_NUM_ARGUMENTS],
+		    int               *mismatches,
+		    int               *numWithout) {
+    static const signed char noMultiples[LUNAR_NUM_ARGUMENTS] = LUNAR_NO_MULTIPLES;
+    const double scales[5] = { M_PI / 180, M_PI / 180, 1E-4 * M_PI / 180, 1E-6 * M_PI / 180, 1E-8 * M_PI / 180 };
+    double coefficients[5];
+    for (int c = 0; c < numCoefficients; c++) {
+	coefficients[c] = a[c] * scales[c];
+    }
+    signed char multiples[LUNAR_NUM_ARGUMENTS] = LUNAR_NO_MULTIPLES;
+    searchLunarArgumentMultiples(coefficients, numCoefficients, multiples);
+    if (memcmp(multiples, expected, sizeof(multiples)) != 0) {
+	(*mismatches)++;
+    }
+    if (memcmp(multiples, noMultiples, sizeof(multiples)) == 0) {
+	(*numWithout)++;
+    }
+}
+
+#define CHECK_LUNAR_MULTIPLES(src, arg)						\
+    for (int i = 0; i < NUM_LUNAR_TERMS(src); i++) {				\
+	const double a[5] = { src[i].arg##0, src[i].arg##1, src[i].arg##2,	\
+			      src[i].arg##3, src[i].arg##4 };			\
+	checkLunarMultiples(a, 5, src##Multiples[i], &mismatches, &numWithout);	\
+    }									\
+    numTerms += NUM_LUNAR_TERMS(src)
+
+#define CHECK_LUNAR_SHORT_MULTIPLES(src, arg)					\
+    for (int i = 0; i < NUM_LUNAR_TERMS(src); i++) {				\
+	const double a[5] = { src[i].arg##0, src[i].arg##1, 0, 0, 0 };		\
+	checkLunarMultiples(a, 2, src##Multiples[i], &mismatches, &numWithout);	\
+    }									\
+    numTerms += NUM_LUNAR_TERMS(src)
+
+static void LUNARMULTIPLES() {
+    int mismatches = 0;
+    int numTerms = 0;
+    int numWithout = 0;
+    clock_t startClock = clock();
+    CHECK_LUNAR_MULTIPLES(Sv, an);
+    CHECK_LUNAR_SHORT_MULTIPLES(Sv1, an);
+    CHECK_LUNAR_SHORT_MULTIPLES(Sv2, an);
+    CHECK_LUNAR_SHORT_MULTIPLES(Sv3, an);
+    CHECK_LUNAR_MULTIPLES(Su, bn);
+    CHECK_LUNAR_SHORT_MULTIPLES(Su1, bn);
+    CHECK_LUNAR_SHORT_MULTIPLES(Su2, bn);
+    CHECK_LUNAR_SHORT_MULTIPLES(Su3, bn);
+    CHECK_LUNAR_MULTIPLES(Sr, dn);
+    CHECK_LUNAR_SHORT_MULTIPLES(Sr1, dn);
+    CHECK_LUNAR_SHORT_MULTIPLES(Sr2, dn);
+    CHECK_LUNAR_SHORT_MULTIPLES(Sr3, dn);
+    double searchSeconds = (double)(clock() - startClock) / CLOCKS_PER_SEC;
+    startClock = clock();
+    const int numBuilds = 100;
+    for (int i = 0; i < numBuilds; i++) {
+	free((void *)makeLunarSeriesTables());
+    }
+    double buildSeconds = (double)(clock() - startClock) / CLOCKS_PER_SEC / numBuilds;
+    printf("LUNARMULTIPLES: %s %d mismatches, %d of %d terms without multiples, search %.1f ms, table build %.3f ms\n",
+	   mismatches == 0 ? "ok  " : "FAIL", mismatches, numWithout, numTerms, searchSeconds * 1e3, buildSeconds * 1e3);
+    const LunarSeriesTables *tables = lunarSeriesTables();
+    const double ts[4] = { 1, 5, 20, 60 };
+    for (int j = 0; j < 4; j++) {
+	int numDecomposed = 0;
+	int numFallbacks = 0;
+	for (int sign = -1; sign <= 1; sign += 2) {
+	    double t = sign * ts[j];
+	    countLunarResidualFallbacks(tables->v, NUM_LUNAR_TERMS(Sv), 5, t, &numDecomposed, &numFallbacks);
+	    countLunarResidualFallbacks(tables->v1, NUM_LUNAR_TERMS(Sv1), 2, t, &numDecomposed, &numFallbacks);
+	    countLunarResidualFallbacks(tables->v2, NUM_LUNAR_TERMS(Sv2), 2, t, &numDecomposed, &numFallbacks);
+	    countLunarResidualFallbacks(tables->v3, NUM_LUNAR_TERMS(Sv3), 2, t, &numDecomposed, &numFallbacks);
+	    countLunarResidualFallbacks(tables->u, NUM_LUNAR_TERMS(Su), 5, t, &numDecomposed, &numFallbacks);
+	    countLunarResidualFallbacks(tables->u1, NUM_LUNAR_TERMS(Su1), 2, t, &numDecomposed, &numFallbacks);
+	    countLunarResidualFallbacks(tables->u2, NUM_LUNAR_TERMS(Su2), 2, t, &numDecomposed, &numFallbacks);
+	    countLunarResidualFallbacks(tables->u3, NUM_LUNAR_TERMS(Su3), 2, t, &numDecomposed, &numFallbacks);
+	    countLunarResidualFallbacks(tables->r, NUM_LUNAR_TERMS(Sr), 5, t, &numDecomposed, &numFallbacks);
+	    countLunarResidualFallbacks(tables->r1, NUM_LUNAR_TERMS(Sr1), 2, t, &numDecomposed, &numFallbacks);
+	    countLunarResidualFallbacks(tables->r2, NUM_LUNAR_TERMS(Sr2), 2, t, &numDecomposed, &numFallbacks);
+	    countLunarResidualFallbacks(tables->r3, NUM_LUNAR_TERMS(Sr3), 2, t, &numDecomposed, &numFallbacks);
+	}
+	printf("LUNARMULTIPLES: at +-%2.0f centuries %4.1f%% of decomposed terms need cos and sin of the residual\n",
+	       ts[j], 100.0 * numFallbacks / numDecomposed);
+    }
+}
+
+#undef CHECK_LUNAR_MULTIPLES
+#undef CHECK_LUNAR_SHORT_MULTIPLES
+
+static void BENCHMARKOUTER() {
+    BENCHMARKOUTER1("jupiter", &jupiterDescriptor, jupiterIndex());
+    BENCHMARKOUTER1("saturn", &saturnDescriptor, saturnIndex());
+    BENCHMARKOUTER1("uranus", &uranusDescriptor, uranusIndex());
+    BENCHMARKOUTER1("neptune", &neptuneDescriptor, neptuneIndex());
+}
+
 int main() {
     ETConversionMethod = ETUseChapront;  // Use for testing only
 #ifdef EXAMPLE1_THRU_4A
@@ -2616,6 +3696,9 @@ int main() {
     ETConversionMethod = ETUseMeeus;
     EXAMPLEX();
     ETConversionMethod = ETUseMeeus;
+    BENCHMARKOUTER();
+    BENCHMARKALLPLANETS();
+    LUNARMULTIPLES();
 }
 #endif  // STANDALONE
 #endif  // NDEBUG
@@ -44,6 +44,36 @@ extern double WB_MoonDistance(double centuriesSinceEpochTDT,
 extern double WB_MoonAscendingNodeLongitude(double centuriesSinceEpochTDT,
 					    ECAstroCache *currentCache);
 
+// Number of terms of each of the four series (main, 1, 2, 3) making up longitude, latitude, and distance
+typedef struct _ECWBLunarSeriesPlan {
+    int longitudeTerms[4];
+    int latitudeTerms[4];
+    int distanceTerms[4];
+} ECWBLunarSeriesPlan;
+
+// Fill in a plan using the fewest terms which keep the truncation error (relative to the full series) within the given
+// tolerances for any time within maxAbsCenturiesSinceEpochTDT of the epoch.  Callers evaluating many instants in an era
+// should make one plan and reuse it.
+extern void WB_lunarSeriesPlanForTolerance(double              longitudeArcseconds,
+					   double              latitudeArcseconds,
+					   double              distanceKm,
+					   double              maxAbsCenturiesSinceEpochTDT,
+					   ECWBLunarSeriesPlan *plan);
+// Ecliptic longitude and latitude (radians) and distance (km), as WB_MoonEclipticLongitude etc. return
+extern void WB_MoonPositionForPlan(double                    centuriesSinceEpochTDT,
+				   const ECWBLunarSeriesPlan *plan,
+				   double                    *longitudeReturn,
+				   double                    *latitudeReturn,
+				   double                    *distanceReturn);
+// Plans for just this instant, then evaluates
+extern void WB_MoonPositionWithTolerance(double centuriesSinceEpochTDT,
+					 double longitudeArcseconds,
+					 double latitudeArcseconds,
+					 double distanceKm,
+					 double *longitudeReturn,
+					 double *latitudeReturn,
+					 double *distanceReturn);
+
 extern double WB_sunLongitudeRaw(double hundredCenturiesSinceEpochTDT,
 				 ECAstroCache *currentCache);
 extern double WB_sunLongitudeApparent(double hundredCenturiesSinceEpochTDT,
@@ -66,6 +96,31 @@ void WB_nutationObliquity(double hundredCenturiesSinceEpochTDT,
 			  double *obliquityReturn,
 			  ECAstroCache *currentCache);
 
+// Same as WB_nutationObliquity for each of count instants, without the cache
+void WB_nutationObliquityBatch(const double *hundredCenturiesSinceEpochTDT,
+			       int count,
+			       double *nutationReturn,
+			       double *obliquityReturn);
+
+// The quantities every apparent-position calculation at one instant shares, so they can be computed once and then
+// passed to WB_planetApparentPositionInFrame for each body.  Angles in radians, distances in AU.
+typedef struct _ECWBFrame {
+    double hundredCenturiesSinceEpochTDT;
+    double sunLongitude;            // without aberration or nutation, as WB_sunLongitudeRadiusRaw
+    double sunRadius;
+    double sunLongitudeAberration;
+    double nutation;                // in longitude
+    double obliquity;               // true obliquity
+    double cosObliquity;
+    double sinObliquity;
+    double xSunGeo;                 // geocentric ecliptic position of the Sun
+    double ySunGeo;
+} ECWBFrame;
+
+void WB_frameForTDT(double hundredCenturiesSinceEpochTDT,
+		    ECWBFrame *frame,
+		    ECAstroCache *currentCache);
+
 void WB_planetApparentPosition(int planetNumber,
 			       double hundredCenturiesSinceEpochTDT,
 			       double *geocentricApparentLongitude,
@@ -75,6 +130,39 @@ void WB_planetApparentPosition(int planetNumber,
 			       double *apparentDeclination,
 			       ECAstroCache *currentCache,
 			       ECWBPrecision moonPrecision);
+void WB_planetApparentPositionInFrame(int planetNumber,
+				      const ECWBFrame *frame,
+				      double *geocentricApparentLongitude,
+				      double *geocentricApparentLatitude,
+				      double *geocentricDistance,
+				      double *apparentRightAscension,
+				      double *apparentDeclination,
+				      ECAstroCache *currentCache,
+				      ECWBPrecision moonPrecision);
+
+// One body's position as WB_planetApparentPosition returns it
+typedef struct _ECWBApparentPosition {
+    double geocentricApparentLongitude;
+    double geocentricApparentLatitude;
+    double geocentricDistance;  // In AU
+    double apparentRightAscension;
+    double apparentDeclination;
+} ECWBApparentPosition;
+
+#define ECWBPlanetMask(planetNumber) (1u << (planetNumber))
+#define ECWBAllPlanetsMask (ECWBPlanetMask(ECPlanetSun) | ECWBPlanetMask(ECPlanetMoon) | \
+			    ECWBPlanetMask(ECPlanetMercury) | ECWBPlanetMask(ECPlanetVenus) | ECWBPlanetMask(ECPlanetMars) | \
+			    ECWBPlanetMask(ECPlanetJupiter) | ECWBPlanetMask(ECPlanetSaturn) | \
+			    ECWBPlanetMask(ECPlanetUranus) | ECWBPlanetMask(ECPlanetNeptune))
+
+// Fills in positions[planetNumber] for each body in planetMask (a subset of ECWBAllPlanetsMask), leaving the other
+// entries alone; positions must have room for ECLastLegalPlanet + 1 entries.  The Sun's position, nutation, and
+// obliquity are computed once for all of them.
+void WB_allPlanetsApparentPosition(double hundredCenturiesSinceEpochTDT,
+				   unsigned int planetMask,
+				   ECWBApparentPosition *positions,
+				   ECAstroCache *currentCache,
+				   ECWBPrecision moonPrecision);
 
 double WB_planetHeliocentricLongitude(int planetNumber,
 				      double hundredCenturiesSinceEpochTDT,
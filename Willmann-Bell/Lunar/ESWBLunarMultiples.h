@@ -0,0 +1,1373 @@
+//
+//  ESWBLunarMultiples.h
+//  Emerald Chronometer
+//
+//  Generated from the tables in ESWBLunarTable.h; see LUNARMULTIPLES in ESWillmannBell.cpp, which checks this file
+//  against the search it was generated by.
+//
+//  For each term of each lunar series, the multiples of the fundamental arguments (D, l', l, F) whose combination is
+//  closest to the term's argument, i.e. which leave the smallest non-constant residual over +-60 centuries, searching
+//  multiples up to 6.  LUNAR_NO_MULTIPLES marks the terms (mostly planetary perturbations) for which no combination
+//  keeps that residual under 0.02 radians; those are evaluated with their own sine.
+
+#define LUNAR_NO_MULTIPLES { 127, 127, 127, 127 }
+
+static const signed char SvMultiples[218][4] = {
+    {  0,  0,  1,  0 },
+    {  2,  0, -1,  0 },
+    {  2,  0,  0,  0 },
+    {  0,  0,  2,  0 },
+    {  0,  1,  0,  0 },
+    {  0,  0,  0,  2 },
+    {  2,  0, -2,  0 },
+    {  2, -1, -1,  0 },
+    {  2,  0,  1,  0 },
+    {  2, -1,  0,  0 },
+    {  0,  1, -1,  0 },
+    {  1,  0,  0,  0 },
+    {  0,  1,  1,  0 },
+    {  2,  0,  0, -2 },
+    {  0,  0,  1,  2 },
+    {  0,  0,  1, -2 },
+    {  4,  0, -1,  0 },
+    {  0,  0,  3,  0 },
+    {  4,  0, -2,  0 },
+    {  2,  1, -1,  0 },
+    {  2,  1,  0,  0 },
+    {  1,  0, -1,  0 },
+    {  1,  1,  0,  0 },
+    {  2, -1,  1,  0 },
+    {  2,  0,  2,  0 },
+    {  4,  0,  0,  0 },
+    {  2,  0, -3,  0 },
+    {  0,  1, -2,  0 },
+    {  2,  0, -1,  2 },
+    {  2, -1, -2,  0 },
+    {  1,  0,  1,  0 },
+    {  2, -2,  0,  0 },
+    {  0,  1,  2,  0 },
+    {  0,  2,  0,  0 },
+    {  2, -2, -1,  0 },
+    {  2,  0,  1, -2 },
+    {  2,  0,  0,  2 },
+    {  4, -1, -1,  0 },
+    {  0,  0,  2,  2 },
+    {  3,  0, -1,  0 },
+    {  2,  1,  1,  0 },
+    {  4, -1, -2,  0 },
+    {  0,  2, -1,  0 },
+    {  2,  2, -1,  0 },
+    {  2,  1, -2,  0 },
+    {  2, -1,  0, -2 },
+    {  4,  0,  1,  0 },
+    {  0,  0,  4,  0 },
+    {  4, -1,  0,  0 },
+    {  1,  0, -2,  0 },
+    {  2,  1,  0, -2 },
+    {  0,  0,  2, -2 },
+    {  1,  1,  1,  0 },
+    {  3,  0, -2,  0 },
+    {  4,  0, -3,  0 },
+    {  2, -1,  2,  0 },
+    {  0,  2,  1,  0 },
+    {  1,  1, -1,  0 },
+    {  2,  0,  3,  0 },
+    {  2,  0,  1,  2 },
+    {  2,  0, -4,  0 },
+    {  2, -2,  1,  0 },
+    {  0,  1, -3,  0 },
+    {  4,  1, -1,  0 },
+    {  1,  0,  2,  0 },
+    {  1,  0,  0, -2 },
+    {  6,  0, -2,  0 },
+    {  2,  0, -2, -2 },
+    {  1, -1,  0,  0 },
+    {  0,  1,  3,  0 },
+    {  2,  0, -2,  2 },
+    {  2, -1, -3,  0 },
+    {  2,  0,  2, -2 },
+    {  2, -1, -1,  2 },
+    {  0,  0,  0,  4 },
+    {  0,  1,  0,  2 },
+    {  3,  0,  0,  0 },
+    {  6,  0, -1,  0 },
+    {  2, -1,  0,  2 },
+    {  2, -1,  1, -2 },
+    {  4,  1, -2,  0 },
+    {  1,  1, -2,  0 },
+    {  2, -3,  0,  0 },
+    {  0,  0,  3,  2 },
+    {  4, -2, -1,  0 },
+    {  0,  1, -1, -2 },
+    {  4,  0, -1, -2 },
+    {  2, -2, -2,  0 },
+    {  6,  0, -3,  0 },
+    {  2,  1,  2,  0 },
+    {  4,  1,  0,  0 },
+    {  4, -1,  1,  0 },
+    {  3,  1, -1,  0 },
+    {  0,  1,  1,  2 },
+    {  1,  0,  0,  2 },
+    {  3,  0,  0, -2 },
+    {  2,  2, -2,  0 },
+    {  2, -3, -1,  0 },
+    {  3, -1, -1,  0 },
+    {  4,  0,  2,  0 },
+    {  4,  0, -1,  2 },
+    {  0,  2, -2,  0 },
+    {  2,  2,  0,  0 },
+    {  2,  0, -1, -2 },
+    {  2,  1, -3,  0 },
+    {  4,  0, -2,  2 },
+    {  4, -2, -2,  0 },
+    {  4, -2,  0,  0 },
+    {  3,  1,  0,  0 },
+    {  1, -1, -1,  0 },
+    {  1,  0, -3,  0 },
+    {  6,  0,  0,  0 },
+    {  2,  0,  2,  2 },
+    {  1, -1,  1,  0 },
+    {  0,  0,  5,  0 },
+    {  0,  3,  0,  0 },
+    {  4, -1, -3,  0 },
+    {  2, -1,  3,  0 },
+    {  1,  1,  2,  0 },
+    {  2,  0, -3, -2 },
+    {  0,  0,  1,  4 },
+    {  6, -1, -2,  0 },
+    {  4,  0,  0,  2 },
+    {  2,  1,  1, -2 },
+    {  3, -1, -2,  0 },
+    {  0,  1,  1, -2 },
+    {  0,  1, -1,  2 },
+    {  0,  0,  1, -4 },
+    {  2,  0,  4,  0 },
+    {  2,  0,  0, -4 },
+    {  0,  1,  0, -2 },
+    {  2, -1,  1,  2 },
+    {  6, -1, -1,  0 },
+    {  2,  0, -5,  0 },
+    {  2,  1, -1,  2 },
+    {  4,  0,  1, -2 },
+    {  2,  1,  0,  2 },
+    {  0,  2,  2,  0 },
+    {  3, -1,  0,  0 },
+    {  2, -2,  2,  0 },
+    {  2, -2,  0, -2 },
+    {  2, -1, -1, -2 },
+    {  5,  0, -2,  0 },
+    {  0,  0,  3, -2 },
+    {  0,  1, -2, -2 },
+    {  0,  3, -1,  0 },
+    {  4,  1,  1,  0 },
+    {  0,  1, -4,  0 },
+    {  1,  0,  1,  2 },
+    {  3,  0, -3,  0 },
+    {  0,  1,  2,  2 },
+    {  1, -2,  0,  0 },
+    {  3,  1, -2,  0 },
+    {  1,  0,  3,  0 },
+    {  1,  0,  1, -2 },
+    {  1,  2,  0,  0 },
+    {  0,  1,  4,  0 },
+    {  6, -1, -3,  0 },
+    {  1,  1,  0,  2 },
+    {  4,  2, -2,  0 },
+    {  2,  0,  3, -2 },
+    {  2, -3,  1,  0 },
+    {  4, -1,  2,  0 },
+    {  3,  0, -1, -2 },
+    {  2, -1, -4,  0 },
+    {  2, -1,  2, -2 },
+    {  2, -1, -2, -2 },
+    {  4,  1, -3,  0 },
+    {  0,  1,  2, -2 },
+    {  2,  1,  3,  0 },
+    {  0,  0,  4,  2 },
+    {  6, -1,  0,  0 },
+    {  0,  1, -2,  2 },
+    {  4, -2,  1,  0 },
+    {  4,  0,  0, -2 },
+    {  1,  0, -1, -2 },
+    {  2,  2,  0, -2 },
+    {  1,  1, -3,  0 },
+    {  4, -1, -1, -2 },
+    {  6,  0,  1,  0 },
+    {  4, -1, -1,  2 },
+    {  3,  1,  1,  0 },
+    {  4,  2, -1,  0 },
+    {  2, -1, -2,  2 },
+    {  4,  0,  3,  0 },
+    {  2,  0, -1,  4 },
+    {  3, -1,  0, -2 },
+    {  4,  1, -1, -2 },
+    {  2,  1, -4,  0 },
+    {  2, -2,  0,  2 },
+    {  0,  3,  1,  0 },
+    {  4,  0,  1,  2 },
+    {  4, -3, -1,  0 },
+    {  5,  0, -3,  0 },
+    {  2, -2,  1, -2 },
+    {  2,  1,  1,  2 },
+    {  1,  0, -1,  2 },
+    {  2, -2, -3,  0 },
+    {  2, -2, -1,  2 },
+    {  4, -1, -2,  2 },
+    {  0,  2, -3,  0 },
+    {  1, -1,  2,  0 },
+    {  6,  0, -4,  0 },
+    {  2,  0,  0,  4 },
+    {  5,  0, -1,  0 },
+    {  2,  2,  1,  0 },
+    {  2,  0,  3,  2 },
+    {  2, -4,  0,  0 },
+    {  0,  0,  2,  4 },
+    {  6,  1, -2,  0 },
+    {  1, -1,  0, -2 },
+    {  3,  0, -1,  2 },
+    {  3, -2, -1,  0 },
+    {  4, -1,  0,  2 },
+    {  2,  0, -4, -2 },
+    {  6,  1, -1,  0 },
+    {  3,  0,  1, -2 },
+    {  2, -1,  2,  2 },
+};
+
+static const signed char Sv1Multiples[244][4] = {
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    {  2,  0, -1,  0 },
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    {  2,  0,  0,  0 },
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    {  0,  2,  6, -6 },
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+};
+
+static const signed char Sv2Multiples[154][4] = {
+    {  0,  1,  0,  0 },
+    {  2, -1, -1,  0 },
+    {  2, -1,  0,  0 },
+    {  0,  1, -1,  0 },
+    {  0,  1,  1,  0 },
+    LUNAR_NO_MULTIPLES,
+    {  2,  1, -1,  0 },
+    {  2,  1,  0,  0 },
+    {  1,  1,  0,  0 },
+    {  2, -2,  0,  0 },
+    {  0,  2,  0,  0 },
+    {  2, -2, -1,  0 },
+    {  2, -1,  1,  0 },
+    {  0,  1, -2,  0 },
+    {  2, -1, -2,  0 },
+    {  0,  1,  2,  0 },
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    {  0,  2, -1,  0 },
+    {  2,  2, -1,  0 },
+    {  4, -1, -1,  0 },
+    {  2,  0,  0,  0 },
+    LUNAR_NO_MULTIPLES,
+    {  2,  0, -1,  0 },
+    {  2,  1,  1,  0 },
+    {  4, -1, -2,  0 },
+    {  2,  1, -2,  0 },
+    {  0,  2,  1,  0 },
+    {  2, -1,  0, -2 },
+    {  4, -1,  0,  0 },
+    {  2, -2,  1,  0 },
+    {  2,  1,  0, -2 },
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    {  1,  1,  1,  0 },
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    {  2, -1,  2,  0 },
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    {  1,  1, -1,  0 },
+    {  2, -3,  0,  0 },
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    {  2, -3, -1,  0 },
+    {  0,  1, -3,  0 },
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    {  4,  1, -1,  0 },
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    {  4, -2, -1,  0 },
+    {  0,  0,  1,  0 },
+    {  2, -2, -2,  0 },
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    {  1, -1,  0,  0 },
+    {  0,  1,  3,  0 },
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    {  2,  0,  1,  0 },
+    {  2,  2, -2,  0 },
+    LUNAR_NO_MULTIPLES,
+    {  2, -1, -3,  0 },
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    {  2, -1, -1,  2 },
+    LUNAR_NO_MULTIPLES,
+    {  0,  1,  0,  2 },
+    {  0,  2, -2,  0 },
+    {  2, -1,  0,  2 },
+    LUNAR_NO_MULTIPLES,
+    {  2,  2,  0,  0 },
+    {  2, -1,  1, -2 },
+    {  4,  1, -2,  0 },
+    LUNAR_NO_MULTIPLES,
+    {  1,  1, -2,  0 },
+    {  4, -2, -2,  0 },
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    {  0,  1, -1, -2 },
+    {  4, -2,  0,  0 },
+    {  0,  3,  0,  0 },
+    {  4,  1,  0,  0 },
+    {  2,  1,  2,  0 },
+    {  4, -1,  1,  0 },
+    LUNAR_NO_MULTIPLES,
+    {  3,  1, -1,  0 },
+    {  0,  1,  1,  2 },
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    {  3, -1, -1,  0 },
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    {  2,  1, -3,  0 },
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    {  4,  0, -1,  0 },
+    LUNAR_NO_MULTIPLES,
+    {  0,  3, -1,  0 },
+    {  3,  1,  0,  0 },
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    {  0,  0,  2,  0 },
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    {  1, -1, -1,  0 },
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    {  0,  2,  2,  0 },
+    LUNAR_NO_MULTIPLES,
+    {  2, -2,  0, -2 },
+    {  2, -2,  2,  0 },
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    {  2,  0, -2,  0 },
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    {  1, -1,  1,  0 },
+};
+
+static const signed char Sv3Multiples[25][4] = {
+    LUNAR_NO_MULTIPLES,
+    {  2, -1, -1,  0 },
+    LUNAR_NO_MULTIPLES,
+    {  0,  1, -1,  0 },
+    {  0,  1,  1,  0 },
+    {  2,  1, -1,  0 },
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    {  0,  2,  0,  0 },
+    {  0,  1, -2,  0 },
+    LUNAR_NO_MULTIPLES,
+    {  0,  1,  2,  0 },
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+};
+
+static const signed char SuMultiples[188][4] = {
+    {  0,  0,  0,  1 },
+    {  0,  0,  1,  1 },
+    {  0,  0,  1, -1 },
+    {  2,  0,  0, -1 },
+    {  2,  0, -1,  1 },
+    {  2,  0, -1, -1 },
+    {  2,  0,  0,  1 },
+    {  0,  0,  2,  1 },
+    {  2,  0,  1, -1 },
+    {  0,  0,  2, -1 },
+    {  2, -1,  0, -1 },
+    {  2,  0, -2, -1 },
+    {  2,  0,  1,  1 },
+    {  2,  1,  0, -1 },
+    {  2, -1, -1,  1 },
+    {  2, -1,  0,  1 },
+    {  2, -1, -1, -1 },
+    {  0,  1, -1, -1 },
+    {  4,  0, -1, -1 },
+    {  0,  1,  0,  1 },
+    {  0,  0,  0,  3 },
+    {  0,  1, -1,  1 },
+    {  1,  0,  0,  1 },
+    {  0,  1,  1,  1 },
+    {  0,  1,  1, -1 },
+    {  0,  1,  0, -1 },
+    {  1,  0,  0, -1 },
+    {  0,  0,  3,  1 },
+    {  4,  0,  0, -1 },
+    {  4,  0, -1,  1 },
+    {  0,  0,  1, -3 },
+    {  4,  0, -2,  1 },
+    {  2,  0,  0, -3 },
+    {  2,  0,  2, -1 },
+    {  2, -1,  1, -1 },
+    {  2,  0, -2,  1 },
+    {  0,  0,  3, -1 },
+    {  2,  0,  2,  1 },
+    {  2,  0, -3, -1 },
+    {  2,  1, -1,  1 },
+    {  2,  1,  0,  1 },
+    {  4,  0,  0,  1 },
+    {  2, -1,  1,  1 },
+    {  2, -2,  0, -1 },
+    {  0,  0,  1,  3 },
+    {  2,  1,  1, -1 },
+    {  1,  1,  0, -1 },
+    {  1,  1,  0,  1 },
+    {  0,  1, -2, -1 },
+    {  2,  1, -1, -1 },
+    {  1,  0,  1,  1 },
+    {  2, -1, -2, -1 },
+    {  0,  1,  2,  1 },
+    {  4,  0, -2, -1 },
+    {  4, -1, -1, -1 },
+    {  1,  0,  1, -1 },
+    {  4,  0,  1, -1 },
+    {  1,  0, -1, -1 },
+    {  4, -1,  0, -1 },
+    {  2, -2,  0,  1 },
+    {  3,  0,  0, -1 },
+    {  4, -1, -1,  1 },
+    {  2,  0, -1, -3 },
+    {  2, -2, -1,  1 },
+    {  0,  1,  2, -1 },
+    {  3,  0, -1, -1 },
+    {  0,  1, -2,  1 },
+    {  2,  0,  1, -3 },
+    {  2, -2, -1, -1 },
+    {  0,  0,  4,  1 },
+    {  2,  0, -3,  1 },
+    {  2,  0, -1,  3 },
+    {  2,  1,  1,  1 },
+    {  4, -1, -2,  1 },
+    {  4,  0,  1,  1 },
+    {  3,  0, -1,  1 },
+    {  4,  1, -1, -1 },
+    {  4, -1,  0,  1 },
+    {  2,  0,  3, -1 },
+    {  2,  0,  0,  3 },
+    {  1,  0, -1,  1 },
+    {  2,  0,  3,  1 },
+    {  2,  2,  0, -1 },
+    {  2,  0, -4, -1 },
+    {  0,  0,  2, -3 },
+    {  2, -1,  2, -1 },
+    {  2, -1,  2,  1 },
+    {  0,  0,  2,  3 },
+    {  0,  2, -1, -1 },
+    {  2,  2, -1,  1 },
+    {  4,  1,  0, -1 },
+    {  1,  0, -2, -1 },
+    {  2,  2, -1, -1 },
+    {  1,  1,  1,  1 },
+    {  0,  2, -1,  1 },
+    {  6,  0, -1, -1 },
+    {  0,  0,  4, -1 },
+    {  2, -1,  0, -3 },
+    {  6,  0, -2, -1 },
+    {  2,  1, -2, -1 },
+    {  1,  0, -2,  1 },
+    {  0,  1, -3, -1 },
+    {  2, -2,  1, -1 },
+    {  2,  0, -2,  3 },
+    {  1,  0,  2,  1 },
+    {  2,  1,  2, -1 },
+    {  4,  0,  0, -3 },
+    {  2, -1, -2,  1 },
+    {  0,  2,  1, -1 },
+    {  0,  1,  3,  1 },
+    {  6,  0, -2,  1 },
+    {  2, -2,  1,  1 },
+    {  0,  2,  0,  1 },
+    {  4, -1,  1, -1 },
+    {  1,  1, -1,  1 },
+    {  0,  2,  1,  1 },
+    {  2, -1, -3, -1 },
+    {  2,  1,  0, -3 },
+    {  2,  1, -2,  1 },
+    {  4, -1, -2, -1 },
+    {  4,  1, -1,  1 },
+    {  3,  0, -2,  1 },
+    {  4,  0,  2, -1 },
+    {  6,  0, -1,  1 },
+    {  3,  0, -2, -1 },
+    {  6,  0,  0, -1 },
+    {  2, -3,  0, -1 },
+    {  1,  0,  2, -1 },
+    {  3,  0,  1, -1 },
+    {  1,  1,  1, -1 },
+    {  4, -2, -1, -1 },
+    {  3,  1,  0, -1 },
+    {  1,  0,  0, -3 },
+    {  2,  1,  2,  1 },
+    {  6,  0, -3,  1 },
+    {  2,  0,  1,  3 },
+    {  4, -1,  1,  1 },
+    {  4,  1, -2,  1 },
+    {  4, -2,  0, -1 },
+    {  3,  0,  0,  1 },
+    {  4,  0,  2,  1 },
+    {  3, -1,  0, -1 },
+    {  4,  1,  0,  1 },
+    {  2,  0, -4,  1 },
+    {  0,  1,  3, -1 },
+    {  4, -2, -1,  1 },
+    {  0,  1, -3,  1 },
+    {  2, -2, -2, -1 },
+    {  4,  0, -3,  1 },
+    {  3, -1, -1, -1 },
+    {  3,  1, -1,  1 },
+    {  2,  0, -2, -3 },
+    {  1, -1,  1, -1 },
+    {  1, -1,  0,  1 },
+    {  2,  1, -3, -1 },
+    {  0,  2,  0, -1 },
+    {  0,  0,  5,  1 },
+    {  4,  1,  1, -1 },
+    {  1,  1, -2,  1 },
+    {  2, -1,  1, -3 },
+    {  2, -3,  0,  1 },
+    {  1,  1, -2, -1 },
+    {  0,  2, -2, -1 },
+    {  6, -1, -1, -1 },
+    {  2,  2,  0,  1 },
+    {  6,  0,  0,  1 },
+    {  3, -1, -1,  1 },
+    {  3,  1,  0,  1 },
+    {  1, -1,  0, -1 },
+    {  3,  1, -1, -1 },
+    {  4, -2,  0,  1 },
+    {  2,  2, -2, -1 },
+    {  1,  0, -3, -1 },
+    {  4, -2, -2,  1 },
+    {  2, -1,  3,  1 },
+    {  2,  0,  4,  1 },
+    {  0,  0,  3,  3 },
+    {  2, -1, -1,  3 },
+    {  0,  1,  0,  3 },
+    {  2,  0, -5, -1 },
+    {  6, -1, -2, -1 },
+    {  5,  0, -1, -1 },
+    {  2, -3, -1,  1 },
+    {  2, -1, -1, -3 },
+    {  1, -1, -1, -1 },
+    {  2,  0,  4, -1 },
+    {  1,  1,  2,  1 },
+    {  3,  0,  0, -3 },
+};
+
+static const signed char Su1Multiples[64][4] = {
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+};
+
+static const signed char Su2Multiples[64][4] = {
+    {  2, -1,  0, -1 },
+    {  2,  1,  0, -1 },
+    {  2, -1, -1,  1 },
+    {  2, -1,  0,  1 },
+    {  2, -1, -1, -1 },
+    {  0,  1, -1, -1 },
+    {  0,  1,  0,  1 },
+    {  0,  1, -1,  1 },
+    {  0,  1,  1,  1 },
+    LUNAR_NO_MULTIPLES,
+    {  0,  1,  1, -1 },
+    {  0,  1,  0, -1 },
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    {  2, -2,  0, -1 },
+    {  2, -1,  1, -1 },
+    LUNAR_NO_MULTIPLES,
+    {  2,  1, -1,  1 },
+    {  2,  1,  0,  1 },
+    {  2,  0,  0, -1 },
+    {  2, -1,  1,  1 },
+    {  2,  1,  1, -1 },
+    {  1,  1,  0,  1 },
+    {  1,  1,  0, -1 },
+    {  0,  1, -2, -1 },
+    {  2,  1, -1, -1 },
+    {  2, -2,  0,  1 },
+    {  2, -1, -2, -1 },
+    {  0,  1,  2,  1 },
+    {  2, -2, -1,  1 },
+    {  4, -1, -1, -1 },
+    {  2, -2, -1, -1 },
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    {  4, -1,  0, -1 },
+    {  4, -1, -1,  1 },
+    {  0,  1,  2, -1 },
+    {  0,  1, -2,  1 },
+    {  2,  2,  0, -1 },
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    {  2,  1,  1,  1 },
+    {  2,  2, -1,  1 },
+    LUNAR_NO_MULTIPLES,
+    {  0,  2, -1, -1 },
+    {  4, -1, -2,  1 },
+    {  2,  2, -1, -1 },
+    {  2,  0,  0,  1 },
+    {  0,  2, -1,  1 },
+    {  4,  1, -1, -1 },
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    {  4, -1,  0,  1 },
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    {  2,  0, -1,  1 },
+    LUNAR_NO_MULTIPLES,
+    {  2, -2,  1, -1 },
+    {  2, -1,  2, -1 },
+    LUNAR_NO_MULTIPLES,
+    {  2, -1,  2,  1 },
+    {  0,  2,  1, -1 },
+};
+
+static const signed char Su3Multiples[12][4] = {
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    {  2, -1,  0,  1 },
+    LUNAR_NO_MULTIPLES,
+    {  2, -1, -1, -1 },
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    {  0,  1,  1, -1 },
+    LUNAR_NO_MULTIPLES,
+    {  0,  1, -1,  1 },
+    {  2, -2,  0, -1 },
+};
+
+static const signed char SrMultiples[154][4] = {
+    {  0,  0,  1,  0 },
+    {  2,  0, -1,  0 },
+    {  2,  0,  0,  0 },
+    {  0,  0,  2,  0 },
+    {  2,  0, -2,  0 },
+    {  2, -1,  0,  0 },
+    {  2,  0,  1,  0 },
+    {  2, -1, -1,  0 },
+    {  0,  1, -1,  0 },
+    {  1,  0,  0,  0 },
+    {  0,  1,  1,  0 },
+    {  0,  0,  1, -2 },
+    {  0,  1,  0,  0 },
+    {  4,  0, -1,  0 },
+    {  2,  1,  0,  0 },
+    {  2,  1, -1,  0 },
+    {  0,  0,  3,  0 },
+    {  4,  0, -2,  0 },
+    {  1,  1,  0,  0 },
+    {  2,  0, -3,  0 },
+    {  2, -1,  1,  0 },
+    {  4,  0,  0,  0 },
+    {  2,  0,  2,  0 },
+    {  2,  0,  0, -2 },
+    {  2, -1, -2,  0 },
+    {  2, -2,  0,  0 },
+    {  2,  0, -1, -2 },
+    {  1,  0, -1,  0 },
+    {  0,  1, -2,  0 },
+    {  1,  0,  1,  0 },
+    {  0,  1,  2,  0 },
+    {  2, -2, -1,  0 },
+    {  0,  0,  2, -2 },
+    {  2,  0,  1, -2 },
+    {  4, -1, -1,  0 },
+    {  3,  0, -1,  0 },
+    {  0,  0,  0,  2 },
+    {  2,  1,  1,  0 },
+    {  2,  2, -1,  0 },
+    {  0,  2, -1,  0 },
+    {  4, -1, -2,  0 },
+    {  1,  0, -2,  0 },
+    {  4, -1,  0,  0 },
+    {  4,  0,  1,  0 },
+    {  3,  0,  0,  0 },
+    {  0,  2,  1,  0 },
+    {  0,  0,  4,  0 },
+    {  0,  2,  0,  0 },
+    {  1,  1,  1,  0 },
+    {  3,  0, -2,  0 },
+    {  1,  1, -1,  0 },
+    {  2, -1,  2,  0 },
+    {  1,  0,  0, -2 },
+    {  2,  0, -4,  0 },
+    {  2,  0, -2,  2 },
+    {  2,  0,  3,  0 },
+    {  2, -2,  1,  0 },
+    {  2, -1,  0, -2 },
+    {  2,  0, -1,  2 },
+    {  4,  1, -1,  0 },
+    {  4,  0, -3,  0 },
+    {  4,  0,  0, -2 },
+    {  1, -1,  0,  0 },
+    {  2, -1, -3,  0 },
+    {  2,  0, -2, -2 },
+    {  6,  0, -2,  0 },
+    {  0,  1, -3,  0 },
+    {  2, -3,  0,  0 },
+    {  1,  0,  2,  0 },
+    {  0,  1,  3,  0 },
+    {  2, -2, -2,  0 },
+    {  0,  1, -1,  2 },
+    {  1,  1, -2,  0 },
+    {  2, -1, -1, -2 },
+    {  4,  0, -1, -2 },
+    {  6,  0, -1,  0 },
+    {  2,  0,  2, -2 },
+    {  4, -2, -1,  0 },
+    {  3, -1, -1,  0 },
+    {  0,  1,  1, -2 },
+    {  4,  1,  0,  0 },
+    {  4,  1, -2,  0 },
+    {  3,  1, -1,  0 },
+    {  2,  1,  2,  0 },
+    {  2, -1,  1, -2 },
+    {  4, -1,  1,  0 },
+    {  3,  0,  0, -2 },
+    {  0,  1,  0, -2 },
+    {  6,  0, -3,  0 },
+    {  2,  1, -3,  0 },
+    {  0,  1,  0,  2 },
+    {  3, -1,  0,  0 },
+    {  2, -3, -1,  0 },
+    {  2,  2,  0,  0 },
+    {  2,  1, -2,  0 },
+    {  4,  0,  2,  0 },
+    {  0,  2, -2,  0 },
+    {  2,  1,  0, -2 },
+    {  4, -2,  0,  0 },
+    {  1, -1, -1,  0 },
+    {  1, -1,  1,  0 },
+    {  2,  2, -2,  0 },
+    {  4, -2, -2,  0 },
+    {  3,  1,  0,  0 },
+    {  0,  0,  1,  2 },
+    {  1,  0, -3,  0 },
+    {  6,  0,  0,  0 },
+    {  4,  0, -2, -2 },
+    {  6, -1, -2,  0 },
+    {  3,  0,  1,  0 },
+    {  1,  0,  1, -2 },
+    {  1,  1,  2,  0 },
+    {  0,  0,  5,  0 },
+    {  2, -1,  3,  0 },
+    {  4, -1,  0, -2 },
+    {  2,  1,  1, -2 },
+    {  3, -1, -2,  0 },
+    {  6, -1, -1,  0 },
+    {  0,  2,  2,  0 },
+    {  0,  1, -2,  2 },
+    {  3,  0, -3,  0 },
+    {  2,  0, -5,  0 },
+    {  2,  1, -1, -2 },
+    {  2, -2,  2,  0 },
+    {  5,  0, -2,  0 },
+    {  2,  0,  4,  0 },
+    {  4, -1, -3,  0 },
+    {  1,  0, -1, -2 },
+    {  0,  3, -1,  0 },
+    {  3,  1, -2,  0 },
+    {  2, -1, -1,  2 },
+    {  1,  2,  0,  0 },
+    {  4,  1,  1,  0 },
+    {  1,  1,  0, -2 },
+    {  0,  1,  2, -2 },
+    {  2,  0,  0,  2 },
+    {  2, -1, -2,  2 },
+    {  1, -2,  0,  0 },
+    {  4,  0, -4,  0 },
+    {  2,  0, -3, -2 },
+    {  2, -3,  1,  0 },
+    {  2, -2,  0, -2 },
+    {  4, -1, -1, -2 },
+    {  0,  1, -4,  0 },
+    {  4,  2, -2,  0 },
+    {  1,  0, -1,  2 },
+    {  6, -1, -3,  0 },
+    {  4,  1, -3,  0 },
+    {  1,  0,  3,  0 },
+    {  2, -1, -4,  0 },
+    {  0,  1,  4,  0 },
+    {  0,  3,  0,  0 },
+    {  4, -1,  2,  0 },
+    {  2,  0, -3,  2 },
+};
+
+static const signed char Sr1Multiples[114][4] = {
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    {  2,  0, -1,  0 },
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+};
+
+static const signed char Sr2Multiples[68][4] = {
+    {  2, -1,  0,  0 },
+    {  2, -1, -1,  0 },
+    {  0,  1, -1,  0 },
+    {  0,  1,  1,  0 },
+    {  0,  1,  0,  0 },
+    {  2,  1,  0,  0 },
+    {  2,  1, -1,  0 },
+    {  2, -2,  0,  0 },
+    {  1,  1,  0,  0 },
+    {  2, -1,  1,  0 },
+    {  2, -1, -2,  0 },
+    {  2, -2, -1,  0 },
+    {  0,  1, -2,  0 },
+    {  0,  1,  2,  0 },
+    {  2,  0,  0,  0 },
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    {  2,  2, -1,  0 },
+    {  0,  2, -1,  0 },
+    {  4, -1, -1,  0 },
+    {  2,  1,  1,  0 },
+    {  2,  0, -1,  0 },
+    {  0,  2,  1,  0 },
+    {  0,  2,  0,  0 },
+    {  4, -1, -2,  0 },
+    {  4, -1,  0,  0 },
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    {  2, -2,  1,  0 },
+    {  2, -3,  0,  0 },
+    {  0,  0,  1,  0 },
+    LUNAR_NO_MULTIPLES,
+    {  1,  1,  1,  0 },
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    {  1,  1, -1,  0 },
+    {  2, -1,  2,  0 },
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    {  2, -2, -2,  0 },
+    {  2, -1,  0, -2 },
+    {  4,  1, -1,  0 },
+    {  4, -2, -1,  0 },
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    {  1, -1,  0,  0 },
+    {  2, -1, -3,  0 },
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    {  2,  0,  1,  0 },
+    {  2, -3, -1,  0 },
+    {  0,  1, -3,  0 },
+    {  0,  1,  3,  0 },
+    {  1,  1, -2,  0 },
+    {  0,  1, -1,  2 },
+    {  2, -1, -1, -2 },
+    {  2,  2,  0,  0 },
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    {  0,  2, -2,  0 },
+    LUNAR_NO_MULTIPLES,
+    {  4, -2,  0,  0 },
+    {  3, -1, -1,  0 },
+    {  0,  1,  1, -2 },
+    {  4,  1,  0,  0 },
+    {  4,  1, -2,  0 },
+};
+
+static const signed char Sr3Multiples[19][4] = {
+    LUNAR_NO_MULTIPLES,
+    {  2, -1, -1,  0 },
+    {  0,  1, -1,  0 },
+    {  0,  1,  1,  0 },
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    {  2,  1, -1,  0 },
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    {  0,  1, -2,  0 },
+    LUNAR_NO_MULTIPLES,
+    {  0,  1,  2,  0 },
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+    LUNAR_NO_MULTIPLES,
+};
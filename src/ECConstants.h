@@ -164,15 +164,16 @@ typedef enum ECPlanetNumber {
 } ECPlanetNumber;
 
 typedef enum ECEclipseKind {
-    ECEclipseNoneSolar    = 0,
-    ECEclipseNoneLunar    = 1,
-    ECEclipseSolarNotUp   = 2,
-    ECEclipsePartialSolar = 3,
-    ECEclipseAnnularSolar = 4,
-    ECEclipseTotalSolar   = 5,
-    ECEclipseLunarNotUp   = 6,
-    ECEclipsePartialLunar = 7,
-    ECEclipseTotalLunar   = 8
+    ECEclipseNoneSolar      = 0,
+    ECEclipseNoneLunar      = 1,
+    ECEclipseSolarNotUp     = 2,
+    ECEclipsePartialSolar   = 3,
+    ECEclipseAnnularSolar   = 4,
+    ECEclipseTotalSolar     = 5,
+    ECEclipseLunarNotUp     = 6,
+    ECEclipsePartialLunar   = 7,
+    ECEclipseTotalLunar     = 8,
+    ECEclipsePenumbralLunar = 9
 } ECEclipseKind;
 
 enum {
@@ -8,6 +8,8 @@
 //
 
 #include <math.h>
+#include <thread>
+#include <vector>
 
 #include "ESAstroConstants.hpp"
 #include "ESAstronomy.hpp"
@@ -310,15 +312,149 @@ static double espenakDeltaT(double yearValue) {  // year value as in 2008.5 for
     return 0;
 }
 
-static bool useMeeusDeltaT = false;
+static double
+modelDeltaT(double        yearValue,
+            ECDeltaTModel model) {
+    return model == ECDeltaTMeeus ? ECMeeusDeltaT(yearValue) : espenakDeltaT(yearValue);
+}
+
+// Each model's delta-T as cubic splines through its values at whole years, over the span in which the models are
+// piecewise; outside it both are single quadratics, which are evaluated directly.  Each era of a model (the span of one
+// of its polynomials, or of the Meeus table) gets its own spline, with knots on both sides of each era boundary and
+// the era's own curvature at its ends, so the spline keeps the model's steps at era boundaries (Espenak's are all
+// under 0.3 s; Meeus's are 41 s at 1620 and 6 s just after 2004) and follows it to within 1 ms elsewhere, except that
+// it smooths the kinks of the Meeus table's linear interpolation by up to 0.09 s.  A lookup is one index computation
+// and one cubic whatever the era.
+#define kECDeltaTSplineFirstYear (-500)
+#define kECDeltaTSplineLastYear  (2150)
+#define kECDeltaTSplineNumKnots  (kECDeltaTSplineLastYear - kECDeltaTSplineFirstYear + 1)
+#define kECDeltaTEraEdge         (1E-6)  // years; an era's end knots are evaluated this far inside it
+
+static const int espenakDeltaTEraBoundaries[] = {
+    kECDeltaTSplineFirstYear, 500, 1600, 1700, 1800, 1860, 1900, 1920, 1941, 1961, 1986, 2005, 2050, kECDeltaTSplineLastYear
+};
+static const int meeusDeltaTEraBoundaries[] = {
+    kECDeltaTSplineFirstYear, 948, 1620, 2004, 2100, kECDeltaTSplineLastYear
+};
+
+typedef struct _DeltaTSpline {
+    double coefficients[kECDeltaTSplineNumKnots - 1][4];  // delta-T a years into each year is c0 + c1*a + c2*a^2 + c3*a^3
+} DeltaTSpline;
+
+static void
+fillDeltaTSplineEra(DeltaTSpline  *spline,
+                    ECDeltaTModel model,
+                    int           firstYear,
+                    int           lastYear) {
+    // Scratch for the one-time fill
+    static double y[kECDeltaTSplineNumKnots];
+    static double M[kECDeltaTSplineNumKnots];
+    static double diagonal[kECDeltaTSplineNumKnots];
+    const int n = lastYear - firstYear + 1;
+    ESAssert(n >= 5);
+    for (int i = 1; i < n - 1; i++) {
+        y[i] = modelDeltaT(firstYear + i, model);
+    }
+    y[0] = modelDeltaT(firstYear + kECDeltaTEraEdge, model);
+    y[n - 1] = modelDeltaT(lastYear - kECDeltaTEraEdge, model);
+    // The ends' second derivatives from one-sided differences (exact for a cubic); then, with unit knot spacing,
+    // M[i-1] + 4M[i] + M[i+1] = 6(y[i+1] - 2y[i] + y[i-1]) for the interior knots, solved by forward elimination and
+    // back substitution
+    M[0] = 2 * y[0] - 5 * y[1] + 4 * y[2] - y[3];
+    M[n - 1] = 2 * y[n - 1] - 5 * y[n - 2] + 4 * y[n - 3] - y[n - 4];
+    diagonal[1] = 4;
+    M[1] = 6 * (y[2] - 2 * y[1] + y[0]) - M[0];
+    for (int i = 2; i < n - 1; i++) {
+        double factor = 1 / diagonal[i - 1];
+        diagonal[i] = 4 - factor;
+        M[i] = 6 * (y[i + 1] - 2 * y[i] + y[i - 1]) - factor * M[i - 1];
+    }
+    M[n - 2] = (M[n - 2] - M[n - 1]) / diagonal[n - 2];
+    for (int i = n - 3; i >= 1; i--) {
+        M[i] = (M[i] - M[i + 1]) / diagonal[i];
+    }
+    for (int i = 0; i < n - 1; i++) {
+        double *c = spline->coefficients[firstYear - kECDeltaTSplineFirstYear + i];
+        c[0] = y[i];
+        c[1] = y[i + 1] - y[i] - (2 * M[i] + M[i + 1]) / 6;
+        c[2] = M[i] / 2;
+        c[3] = (M[i + 1] - M[i]) / 6;
+    }
+}
+
+static const DeltaTSpline *
+makeDeltaTSplines() {
+    static DeltaTSpline splines[ECNumDeltaTModels];
+    for (int model = 0; model < ECNumDeltaTModels; model++) {
+        const int *boundaries = model == ECDeltaTMeeus ? meeusDeltaTEraBoundaries : espenakDeltaTEraBoundaries;
+        int numEras = model == ECDeltaTMeeus
+            ? sizeof(meeusDeltaTEraBoundaries) / sizeof(int) - 1
+            : sizeof(espenakDeltaTEraBoundaries) / sizeof(int) - 1;
+        for (int era = 0; era < numEras; era++) {
+            fillDeltaTSplineEra(&splines[model], (ECDeltaTModel)model, boundaries[era], boundaries[era + 1]);
+        }
+    }
+    return splines;
+}
+
+static const DeltaTSpline *
+deltaTSplineForModel(ECDeltaTModel model) {
+    static const DeltaTSpline *splines = makeDeltaTSplines();
+    return &splines[model];
+}
+
+static inline double
+splineDeltaT(const DeltaTSpline *spline,
+             double             yearValue,
+             ECDeltaTModel      model) {
+    if (!(yearValue >= kECDeltaTSplineFirstYear && yearValue <= kECDeltaTSplineLastYear)) {
+        return modelDeltaT(yearValue, model);
+    }
+    double x = yearValue - kECDeltaTSplineFirstYear;
+    int i = (int)x;
+    if (i > kECDeltaTSplineNumKnots - 2) {
+        i = kECDeltaTSplineNumKnots - 2;
+    }
+    double a = x - i;
+    const double *c = spline->coefficients[i];
+    return c[0] + a * (c[1] + a * (c[2] + a * c[3]));
+}
+
+double
+ECDeltaT(double        yearValue,
+         ECDeltaTModel model) {
+    ESAssert(model >= 0 && model < ECNumDeltaTModels);
+    return splineDeltaT(deltaTSplineForModel(model), yearValue, model);
+}
+
+void
+ECDeltaTBatch(const double  *yearValues,
+              int           count,
+              ECDeltaTModel model,
+              double        *deltaTReturn) {
+    ESAssert(model >= 0 && model < ECNumDeltaTModels);
+    const DeltaTSpline *spline = deltaTSplineForModel(model);
+    for (int i = 0; i < count; i++) {
+        deltaTReturn[i] = splineDeltaT(spline, yearValues[i], model);
+    }
+}
+
+static ECDeltaTModel deltaTModel = ECDeltaTEspenak;
+
+void
+ECSetDeltaTModel(ECDeltaTModel model) {
+    ESAssert(model >= 0 && model < ECNumDeltaTModels);
+    deltaTModel = model;
+}
+
+ECDeltaTModel
+ECGetDeltaTModel() {
+    return deltaTModel;
+}
 
 static double convertUTtoET(double ut,
                             double yearValue) {
-    if (useMeeusDeltaT) {
-        return ut + ECMeeusDeltaT(yearValue);
-    } else {
-        return ut + espenakDeltaT(yearValue);
-    }
+    return ut + ECDeltaT(yearValue, deltaTModel);
 }
 
 #ifndef NDEBUG
@@ -326,12 +462,10 @@ static double convertUTtoET(double ut,
 static void testConversion() {
     //for (int year = 900; year < 2110; year += 2) {
     for (int year = -500; year < 2110; year += 50) {
-        useMeeusDeltaT = true;
-        double newValue = convertUTtoET(0, year);
-        printf("\n%04d %10.3f Meeus\n", year, newValue);
-        useMeeusDeltaT = false;
-        newValue = convertUTtoET(0, year);
-        printf("%04d %10.3f Espenak\n", year, newValue);
+        double newValue = ECDeltaT(year, ECDeltaTMeeus);
+        printf("\n%04d %10.3f Meeus (formula %10.3f)\n", year, newValue, ECMeeusDeltaT(year));
+        newValue = ECDeltaT(year, ECDeltaTEspenak);
+        printf("%04d %10.3f Espenak (formula %10.3f)\n", year, newValue, espenakDeltaT(year));
     }
 }
 #endif  // if 0
@@ -412,6 +546,34 @@ static double northAngleForObject(double altitude,
     return greatCircleCourse(altitude, azimuth, observerLatitude, 0);
 }
 
+// Returns the year value delta-T wants (the astronomical year number, plus the time since 0h UT Jan 1 of that year in
+// Julian years, e.g. 2008.5 for early July) given a UT date.  This is the calendar arithmetic of Meeus ch 7 on the
+// Julian day, using the Julian calendar before 1582 Oct 15 as ESCalendar does, so it needs no date-component
+// conversions and keeps no state.
+static double
+yearValueForDateInterval(ESTimeInterval dateInterval) {
+    double julianDate = julianDateForDate(dateInterval);
+    double Z = floor(julianDate + 0.5);
+    double A = Z;
+    if (Z >= 2299161) {  // 1582 Oct 15
+        double alpha = floor((Z - 1867216.25) / 36524.25);
+        A = Z + 1 + alpha - floor(alpha / 4);
+    }
+    double B = A + 1524;
+    double C = floor((B - 122.1) / 365.25);
+    double D = floor(365.25 * C);
+    double E = floor((B - D) / 30.6001);
+    double year = E < 14 ? C - 4716 : C - 4715;  // E < 14 means March thru December
+    // Jan 1 0h is day 1 of month 13 of the prior year in Meeus' scheme
+    double calendarCorrection = 0;
+    if (year > 1582) {
+        double century = floor((year - 1) / 100);
+        calendarCorrection = 2 - century + floor(century / 4);
+    }
+    double julianDateOfJanuary1 = floor(365.25 * (year - 1 + 4716)) + floor(30.6001 * 14) + 1 + calendarCorrection - 1524.5;
+    return year + (julianDate - julianDateOfJanuary1) / 365.25;
+}
+
 // Returns TDT/ET Julian Centuries since J2000.0 given a UT date
 static double
 julianCenturiesSince2000EpochForDateInterval(ESTimeInterval dateInterval,
@@ -426,24 +588,7 @@ julianCenturiesSince2000EpochForDateInterval(ESTimeInterval dateInterval,
         }
     } else {
         double utSeconds = dateInterval;
-        ESTimeInterval firstOfThisYearInterval;
-        static ESTimeInterval lastCalculatedFirstInterval = 0;
-        static int lastYearValue = 0;
-        if (utSeconds > lastCalculatedFirstInterval && utSeconds < lastCalculatedFirstInterval + (24 * 3600 * 330)) {
-            firstOfThisYearInterval = lastCalculatedFirstInterval;
-        } else {
-            ESDateComponents cs;
-            ESCalendar_UTCDateComponentsFromTimeInterval(dateInterval, &cs);
-            cs.month = 1;
-            cs.day = 1;
-            cs.hour = 0;
-            cs.minute = 0;
-            cs.seconds = 0;
-            firstOfThisYearInterval = ESCalendar_timeIntervalFromUTCDateComponents(&cs);
-            lastCalculatedFirstInterval = firstOfThisYearInterval;
-            lastYearValue = cs.era ? cs.year : 1 - cs.year;
-        }
-        double yearValue = lastYearValue + (utSeconds - firstOfThisYearInterval)/(365.25 * 24 * 3600);
+        double yearValue = yearValueForDateInterval(dateInterval);
         PRINT_DOUBLE(yearValue);
         double etSeconds = convertUTtoET(utSeconds, yearValue);
         if (deltaT) {
@@ -714,12 +859,11 @@ static double convertGSTtoLST(double gst,
     return lst;
 }
 
-// P03; returns seconds
-static double
-convertUTToGSTP03x(double         centuriesSinceEpochTDT,
-                   double         deltaTSeconds,
-                   double         utSinceMidnightRadians,
-                   ESTimeInterval priorUTMidnight) {
+// P03; the GMST polynomial in radians, not yet reduced to [0, 2pi)
+static inline double
+unreducedGSTP03(double centuriesSinceEpochTDT,
+                double deltaTSeconds,
+                double utSinceMidnightRadians) {
     double t = centuriesSinceEpochTDT;
     double tu = t - deltaTSeconds/(24*3600*kECJulianDaysPerCentury);
     double t2 = t*t;
@@ -735,7 +879,16 @@ convertUTToGSTP03x(double         centuriesSinceEpochTDT,
         - 0.000000002454*t5;
     // convert from seconds to radians
     gmst *= M_PI / (12.0 * 3600);
-    gmst += utSinceMidnightRadians;
+    return gmst + utSinceMidnightRadians;
+}
+
+// P03; returns seconds
+static double
+convertUTToGSTP03x(double         centuriesSinceEpochTDT,
+                   double         deltaTSeconds,
+                   double         utSinceMidnightRadians,
+                   ESTimeInterval priorUTMidnight) {
+    double gmst = unreducedGSTP03(centuriesSinceEpochTDT, deltaTSeconds, utSinceMidnightRadians);
     gmst = ESUtil::fmod(gmst, M_PI * 2);
     if (gmst < 0) {
         gmst += M_PI * 2;
@@ -753,6 +906,58 @@ convertUTToGSTP03(double       calculationDate,
     return convertUTToGSTP03x(centuriesSinceEpochTDT, deltaTSeconds, utRadiansSinceMidnight, priorUTMidnightD);
 }
 
+// GMST for a UT date given its delta-T, without calendar calls or the cache:  UT midnights fall on whole days since the
+// reference date.  Not reduced to [0, 2pi)
+static inline double
+unreducedGSTForDeltaT(ESTimeInterval dateInterval,
+                      double         deltaTSeconds) {
+    double priorUTMidnightD = floor(dateInterval / (24 * 3600)) * (24 * 3600);
+    double utRadiansSinceMidnight = (dateInterval - priorUTMidnightD) * M_PI/(12 * 3600);
+    double centuriesSinceEpochTDT = (julianDateForDate(dateInterval + deltaTSeconds) - kECJulianDateOf2000Epoch) / kECJulianDaysPerCentury;
+    return unreducedGSTP03(centuriesSinceEpochTDT, deltaTSeconds, utRadiansSinceMidnight);
+}
+
+// Delta-T for the batch functions, which skip the calendar arithmetic of yearValueForDateInterval:  counting Julian years
+// from J2000 keeps the year value within a month of the calendar one from -4000 to 6000, which moves delta-T by at most
+// a few seconds, and GMST moves by only 1E-7 seconds per second of delta-T (through the 307.48*(t - tu) term)
+static inline double
+batchDeltaTForDateInterval(ESTimeInterval dateInterval) {
+    return ECDeltaT(2000 + (julianDateForDate(dateInterval) - kECJulianDateOf2000Epoch) / 365.25, deltaTModel);
+}
+
+// Each instant gets its own delta-T, so a batch may span any range of dates
+void
+ECGreenwichSiderealTimeBatch(const ESTimeInterval *dateIntervals,
+                             int                  count,
+                             double               *gstReturn) {
+    for (int i = 0; i < count; i++) {
+        double gmst = unreducedGSTForDeltaT(dateIntervals[i], batchDeltaTForDateInterval(dateIntervals[i]));
+        gstReturn[i] = gmst - floor(gmst / (M_PI * 2)) * (M_PI * 2);
+    }
+}
+
+void
+ECLocalSiderealTimeBatch(const ESTimeInterval *dateIntervals,
+                         int                  count,
+                         const double         *observerLongitudes,
+                         int                  longitudeCount,
+                         double               *lstReturn) {
+    ESAssert(count >= 0 && longitudeCount >= 0);
+    std::vector<double> gsts(count);
+    ECGreenwichSiderealTimeBatch(dateIntervals, count, gsts.data());
+    for (int i = 0; i < count; i++) {
+        double gst = gsts[i];
+        double *row = lstReturn + (size_t)i * longitudeCount;
+        for (int j = 0; j < longitudeCount; j++) {  // as convertGSTtoLST, but branch-free
+            double lst = gst + observerLongitudes[j];
+            lst += lst < 0 ? (M_PI * 2) : 0;
+            lst -= lst > (M_PI * 2) ? (M_PI * 2) : 0;
+            row[j] = lst;
+        }
+    }
+}
+
+#ifndef NDEBUG  // only runTests uses it
 static double
 convertGSTtoUT(double           gst,
                ESTimeInterval   priorUTMidnight,
@@ -788,6 +993,7 @@ convertGSTtoUT(double           gst,
     }
     return ut;
 }
+#endif  // NDEBUG
 
 static double
 STDifferenceForDate(ESTimeInterval dateInterval,
@@ -800,48 +1006,44 @@ STDifferenceForDate(ESTimeInterval dateInterval,
     return gst - utRadiansSinceMidnight;
 }
 
+// The UT within half a sidereal day of closestToThisDate at which GMST is gst.  A step at the mean sidereal rate from
+// closestToThisDate lands within a few microseconds; one Newton step with the same rate takes up the rest.
+static inline ESTimeInterval
+closestUTForGSTWithDeltaT(double         gst,
+                          ESTimeInterval closestToThisDate,
+                          double         deltaTSeconds) {
+    ESTimeInterval utD = closestToThisDate;
+    for (int step = 0; step < 2; step++) {
+        double gstDifference = gst - unreducedGSTForDeltaT(utD, deltaTSeconds);
+        gstDifference -= floor(gstDifference / (M_PI * 2) + 0.5) * (M_PI * 2);  // into [-pi, pi)
+        utD += gstDifference * kECUTUnitsPerGSTUnit * (12 * 3600)/M_PI;
+    }
+    return utD;
+}
+
 static ESTimeInterval
 convertGSTtoUTclosest(double           gst,
                       ESTimeInterval   closestToThisDate,
                       ECAstroCachePool *cachePool) {
     PRINT_DATE(closestToThisDate);
-    double priorUTMidnightD = priorUTMidnightForDateInterval(closestToThisDate, cachePool ? cachePool->currentCache : NULL);
+    ECAstroCache *_currentCache = cachePool ? cachePool->currentCache : NULL;
+    if (_currentCache && fabs(_currentCache->dateInterval - closestToThisDate) > ASTRO_SLOP) {
+        _currentCache = NULL;
+    }
+    double deltaTSeconds;
+    julianCenturiesSince2000EpochForDateInterval(closestToThisDate, &deltaTSeconds, _currentCache);
+    return closestUTForGSTWithDeltaT(gst, closestToThisDate, deltaTSeconds);
+}
 
-    // Calculate answer for this UT date
-    double ut0_2;
-    double ut0 = convertGSTtoUT(gst, priorUTMidnightD, &ut0_2, cachePool);
-    double utSecondsSinceMidnight = ut0 * (12 * 3600)/M_PI;
-
-    // seconds since reference date for answer
-    double utD = priorUTMidnightD + utSecondsSinceMidnight;
-
-    // If answer is less than target date - 12h, then we want the next UT date
-    if (utD < closestToThisDate - 12 * 3600.0 * kECUTUnitsPerGSTUnit) {
-        // First see if there is a second, later UT date for the given GST:
-        if (ut0_2 > 0) {
-            PRINT_STRING("...using second UT for this GST\n");
-            ut0 = ut0_2;
-            utSecondsSinceMidnight = ut0 * (12 * 3600)/M_PI;
-            utD = priorUTMidnightD + utSecondsSinceMidnight;
-        } else {
-            PRINT_STRING("...moving forward a day\n");
-            priorUTMidnightD += 24 * 3600.0;
-            ut0 = convertGSTtoUT(gst, priorUTMidnightD, &ut0_2, cachePool);
-            utSecondsSinceMidnight = ut0 * (12 * 3600)/M_PI;
-            utD = priorUTMidnightD + utSecondsSinceMidnight;
-        }
-    } else if (utD > closestToThisDate + 12 * 3600.0 * kECUTUnitsPerGSTUnit) {
-        PRINT_STRING("...backing up a day\n");
-        priorUTMidnightD -= 24 * 3600.0;
-        ut0 = convertGSTtoUT(gst, priorUTMidnightD, &ut0_2, cachePool);
-        if (ut0_2 > 0) { // we want the later of the two if there is one
-            PRINT_STRING("...using later of two UTs for this GST\n");
-            ut0 = ut0_2;
-        }
-        utSecondsSinceMidnight = ut0 * (12 * 3600)/M_PI;
-        utD = priorUTMidnightD + utSecondsSinceMidnight;
+// As convertGSTtoUTclosest for count pairs, with delta-T as in ECGreenwichSiderealTimeBatch
+void
+ECConvertGSTToUTClosestBatch(const double         *gsts,
+                             const ESTimeInterval *closestToTheseDates,
+                             int                  count,
+                             ESTimeInterval       *utReturn) {
+    for (int i = 0; i < count; i++) {
+        utReturn[i] = closestUTForGSTWithDeltaT(gsts[i], closestToTheseDates[i], batchDeltaTForDateInterval(closestToTheseDates[i]));
     }
-    return utD;
 }
 
 // From P03; includes both motion of the equator in the GCRS and the motion of the ecliptic
@@ -907,90 +1109,307 @@ generalPrecessionQuantities(double julianCenturiesSince2000Epoch,
     *thetaA = arcSeconds * M_PI/(3600 * 180);
 }
 
-// P03; uses general precession quantities
-static void
-convertJ2000ToOfDate(double julianCenturiesSince2000Epoch,
-                     double raJ2000,
-                     double declJ2000,
-                     double *raOfDate,
-                     double *declOfDate) {
+// P03; uses general precession quantities.  Rotates J2000 mean equatorial unit vectors into the mean equator and equinox
+// of date:  P = R3(-zA) R2(thetaA) R3(-zetaA).  The reverse conversion is just the transpose.
+void
+ECPrecessionMatrix(double           julianCenturiesSince2000Epoch,
+                   ECRotationMatrix *matrixReturn) {
     double pA, eA, chiA, zetaA, zA, thetaA;
     generalPrecessionQuantities(julianCenturiesSince2000Epoch, &pA, &eA, &chiA, &zetaA, &zA, &thetaA);
-    double cosDecl = cos(declJ2000);
-    double sinDecl = sin(declJ2000);
+    double cosZeta = cos(zetaA);
+    double sinZeta = sin(zetaA);
+    double cosZ = cos(zA);
+    double sinZ = sin(zA);
     double cosTheta = cos(thetaA);
     double sinTheta = sin(thetaA);
-    double term = cosDecl*cos(raJ2000 + zetaA);
-    double A = cosDecl*sin(raJ2000 + zetaA);
-    double B = cosTheta*term - sinTheta*sinDecl;
-    double C = sinTheta*term + cosTheta*sinDecl;
-    double raMinusZ = atan2(A, B);
-    double ra = ESUtil::fmod(raMinusZ + zA, M_PI * 2);
-    if (ra < 0) {
-        ra += M_PI * 2;
+    matrixReturn->m[0][0] =  cosZ*cosTheta*cosZeta - sinZ*sinZeta;
+    matrixReturn->m[0][1] = -cosZ*cosTheta*sinZeta - sinZ*cosZeta;
+    matrixReturn->m[0][2] = -cosZ*sinTheta;
+    matrixReturn->m[1][0] =  sinZ*cosTheta*cosZeta + cosZ*sinZeta;
+    matrixReturn->m[1][1] = -sinZ*cosTheta*sinZeta + cosZ*cosZeta;
+    matrixReturn->m[1][2] = -sinZ*sinTheta;
+    matrixReturn->m[2][0] =  sinTheta*cosZeta;
+    matrixReturn->m[2][1] = -sinTheta*sinZeta;
+    matrixReturn->m[2][2] =  cosTheta;
+}
+
+// P03 precession followed by WB nutation:  NP = R1(-trueObliquity) R3(-nutation) R1(meanObliquity) P.  WB's obliquity
+// already includes the nutation in obliquity, and its 1E-7 precision swamps the difference between its mean obliquity
+// and P03's eA, so we use eA for the mean.
+void
+ECPrecessionNutationMatrix(double           julianCenturiesSince2000Epoch,
+                           ECRotationMatrix *matrixReturn) {
+    ECRotationMatrix precession;
+    ECPrecessionMatrix(julianCenturiesSince2000Epoch, &precession);
+    double nutation;
+    double trueObliquity;
+    WB_nutationObliquity(julianCenturiesSince2000Epoch/100, &nutation, &trueObliquity, NULL);
+    double meanObliquity = generalObliquity(julianCenturiesSince2000Epoch);
+    double cosMean = cos(meanObliquity);
+    double sinMean = sin(meanObliquity);
+    double cosTrue = cos(trueObliquity);
+    double sinTrue = sin(trueObliquity);
+    double cosNutation = cos(nutation);
+    double sinNutation = sin(nutation);
+    double nutationMatrix[3][3] = {
+        {  cosNutation,          -sinNutation*cosMean,                              -sinNutation*sinMean                             },
+        {  sinNutation*cosTrue,   cosNutation*cosMean*cosTrue + sinMean*sinTrue,     cosNutation*sinMean*cosTrue - cosMean*sinTrue   },
+        {  sinNutation*sinTrue,   cosNutation*cosMean*sinTrue - sinMean*cosTrue,     cosNutation*sinMean*sinTrue + cosMean*cosTrue   }
+    };
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            matrixReturn->m[i][j] =
+                nutationMatrix[i][0]*precession.m[0][j] + nutationMatrix[i][1]*precession.m[1][j] + nutationMatrix[i][2]*precession.m[2][j];
+        }
     }
-    *raOfDate = ra;
-    *declOfDate = asin(C);  // Meeus says: if star is close to celestial pole, use decl = acos(sqrt(A*A + B*B)) instead; but for now we're just dealing with things in the ecliptic
 }
 
-// Meeus; P03 does not have formulae for angles to convert back to J2000; see also refineConvertToJ2000FromOfDate below
+// Precession moves the equinox about 50 arcseconds a year, or 5.7 milliarcseconds an hour, so a matrix reused for any date
+// within the slowly-varying group's slop (3600 seconds unless changed) is off by at most 5.7 milliarcseconds
 static void
-convertToJ2000FromOfDate(double julianCenturiesSince2000Epoch,
-                         double raOfDate,
-                         double declOfDate,
-                         double *raJ2000,
-                         double *declJ2000) {
-    double T = julianCenturiesSince2000Epoch;
-    double T2 = T*T;
-    double t = -T;
-    double t2 = t*t;
-    double t3 = t2*t;
-    double arcSeconds = (2306.2181 + 1.39656*T - 0.000139*T2)*t
-        + (0.30188 - 0.000344*T)*t2 + 0.017998*t3;
-    double zetaA = arcSeconds * M_PI/(3600 * 180);
-    arcSeconds = (2306.2181 + 1.39656*T - 0.000139*T2)*t
-        + (1.09468 + 0.000066*T)*t2 + 0.018203*t3;
-    double zA = arcSeconds * M_PI/(3600 * 180);
-    arcSeconds = (2004.3109 - 0.85330*T - 0.000217*T2)*t
-        - (0.42665 + 0.000217*T)*t2 - 0.041833*t3;
-    double thetaA = arcSeconds * M_PI/(3600 * 180);
-    double cosDecl = cos(declOfDate);
-    double sinDecl = sin(declOfDate);
-    double cosTheta = cos(thetaA);
-    double sinTheta = sin(thetaA);
-    double term = cosDecl*cos(raOfDate + zetaA);
-    double A = cosDecl*sin(raOfDate + zetaA);
-    double B = cosTheta*term - sinTheta*sinDecl;
-    double C = sinTheta*term + cosTheta*sinDecl;
-    double raMinusZ = atan2(A, B);
-    double ra = ESUtil::fmod(raMinusZ + zA, M_PI * 2);
-    if (ra < 0) {
-        ra += M_PI * 2;
+cachedPrecessionMatrix(double           julianCenturiesSince2000Epoch,
+                       ECRotationMatrix *matrixReturn,
+                       ECAstroCache     *_currentCache) {
+    double *slots = _currentCache ? &_currentCache->cacheSlots[precessionMatrixSlotIndex] : NULL;
+    if (_currentCache && _currentCache->cacheSlotValidFlag[precessionMatrixSlotIndex] == _currentCache->currentFlag) {
+        for (int i = 0; i < 9; i++) {
+            matrixReturn->m[i / 3][i % 3] = slots[i];
+        }
+        return;
+    }
+    ECPrecessionMatrix(julianCenturiesSince2000Epoch, matrixReturn);
+    if (_currentCache) {
+        for (int i = 0; i < 9; i++) {
+            slots[i] = matrixReturn->m[i / 3][i % 3];
+            _currentCache->cacheSlotValidFlag[precessionMatrixSlotIndex + i] = _currentCache->currentFlag;
+        }
+    }
+}
+
+// The loops below have no branches or calls, so the compiler is free to vectorize them
+void
+ECRotateVectors(const ECRotationMatrix *matrix,
+                bool                   inverse,
+                const double           *x,
+                const double           *y,
+                const double           *z,
+                int                    count,
+                double                 *xReturn,
+                double                 *yReturn,
+                double                 *zReturn) {
+    double m[3][3];
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            m[i][j] = inverse ? matrix->m[j][i] : matrix->m[i][j];
+        }
+    }
+    for (int k = 0; k < count; k++) {
+        double xk = x[k];
+        double yk = y[k];
+        double zk = z[k];
+        xReturn[k] = m[0][0]*xk + m[0][1]*yk + m[0][2]*zk;
+        yReturn[k] = m[1][0]*xk + m[1][1]*yk + m[1][2]*zk;
+        zReturn[k] = m[2][0]*xk + m[2][1]*yk + m[2][2]*zk;
+    }
+}
+
+static void
+rotateRADecl(const ECRotationMatrix *matrix,
+             bool                   inverse,
+             double                 ra,
+             double                 decl,
+             double                 *raReturn,
+             double                 *declReturn) {
+    double cosDecl = cos(decl);
+    double x = cosDecl*cos(ra);
+    double y = cosDecl*sin(ra);
+    double z = sin(decl);
+    double xr, yr, zr;
+    ECRotateVectors(matrix, inverse, &x, &y, &z, 1, &xr, &yr, &zr);
+    double raOut = atan2(yr, xr);
+    if (raOut < 0) {
+        raOut += M_PI * 2;
+    }
+    *raReturn = raOut;
+    *declReturn = atan2(zr, sqrt(xr*xr + yr*yr));  // unlike asin, accurate near the poles
+}
+
+void
+ECRotateRADecl(const ECRotationMatrix *matrix,
+               bool                   inverse,
+               const double           *ra,
+               const double           *decl,
+               int                    count,
+               double                 *raReturn,
+               double                 *declReturn) {
+    for (int k = 0; k < count; k++) {
+        rotateRADecl(matrix, inverse, ra[k], decl[k], &raReturn[k], &declReturn[k]);
     }
-    *raJ2000 = ra;
-    *declJ2000 = asin(C);  // Meeus says: if star is close to celestial pole, use decl = acos(sqrt(A*A + B*B)) instead
 }
 
-// Meeus gets very close (10 arcseconds?), but this will get us as exact as we need.  Initial plus 2 refines gets us to within .01 arcsecond
+// Precession only: the of-date positions we're given are apparent, and callers want them in J2000 with nutation left in
+static void
+convertToJ2000FromOfDate(double         julianCenturiesSince2000Epoch,
+                         double         raOfDate,
+                         double         declOfDate,
+                         double         *raJ2000,
+                         double         *declJ2000,
+                         ECAstroCache   *_currentCache) {
+    ECRotationMatrix precession;
+    cachedPrecessionMatrix(julianCenturiesSince2000Epoch, &precession, _currentCache);
+    rotateRADecl(&precession, true/*inverse*/, raOfDate, declOfDate, raJ2000, declJ2000);
+}
+
+// Per-call constants for ECApparentPositionsForCatalogue, shared read-only by the worker threads
+typedef struct CatalogueFrame {
+    ECRotationMatrix precessionNutation;
+    double           yearsSinceJ2000;   // for proper motion
+    double           aberration[3];     // Earth's velocity over c, true equator and equinox of date
+    double           cosLST;
+    double           sinLST;
+    double           cosLatitude;
+    double           sinLatitude;
+} CatalogueFrame;
+
+// Meeus ch 23:  the Earth moves toward the Sun's longitude minus 90 degrees, with an eccentricity correction toward
+// the perihelion.  Good to a few hundredths of an arcsecond, which is all the Ron-Vondrak terms would buy us for stars.
+static void
+earthVelocityOverC(double julianCenturiesSince2000Epoch,
+                   double trueObliquity,
+                   double *velocityReturn) {
+    double T = julianCenturiesSince2000Epoch;
+    double kappa = 20.49552 * M_PI/(3600 * 180);
+    double eccentricity = 0.016708634 - 0.000042037*T - 0.0000001267*T*T;
+    double perihelion = (102.93735 + 1.71946*T + 0.00046*T*T) * M_PI/180;
+    double sunLongitude;
+    double sunRadius;
+    WB_sunLongitudeRadiusRaw(T/100, &sunLongitude, &sunRadius, NULL);
+    double cosObliquity = cos(trueObliquity);
+    double sinObliquity = sin(trueObliquity);
+    double vx = sin(sunLongitude) - eccentricity*sin(perihelion);
+    double vy = -cos(sunLongitude) + eccentricity*cos(perihelion);
+    velocityReturn[0] = kappa*vx;
+    velocityReturn[1] = kappa*vy*cosObliquity;
+    velocityReturn[2] = kappa*vy*sinObliquity;
+}
+
 static void
-refineConvertToJ2000FromOfDate(double julianCenturiesSince2000Epoch,
-                               double raOfDate,
-                               double declOfDate,
-                               double *raJ2000,
-                               double *declJ2000) {
-    double raTry2000, declTry2000;
-    convertToJ2000FromOfDate(julianCenturiesSince2000Epoch, raOfDate, declOfDate, &raTry2000, &declTry2000);
-    double raRoundTrip, declRoundTrip;
-    convertJ2000ToOfDate(julianCenturiesSince2000Epoch, raTry2000, declTry2000, &raRoundTrip, &declRoundTrip);
-    double raOfDateTweak = raOfDate + (raOfDate - raRoundTrip);
-    double declOfDateTweak = declOfDate + (declOfDate - declRoundTrip);
-    convertToJ2000FromOfDate(julianCenturiesSince2000Epoch, raOfDateTweak, declOfDateTweak, &raTry2000, &declTry2000);
-    convertJ2000ToOfDate(julianCenturiesSince2000Epoch, raTry2000, declTry2000, &raRoundTrip, &declRoundTrip);
-    raOfDateTweak = raOfDateTweak + (raOfDate - raRoundTrip); 
-    declOfDateTweak = declOfDateTweak + (declOfDate - declRoundTrip);
-    convertToJ2000FromOfDate(julianCenturiesSince2000Epoch, raOfDateTweak, declOfDateTweak, &raTry2000, &declTry2000);
-    *raJ2000 = raTry2000;
-    *declJ2000 = declTry2000;
+apparentPositionsForCatalogueRange(const CatalogueFrame *frame,
+                                   const double         *raJ2000,
+                                   const double         *declJ2000,
+                                   const double         *pmRA,
+                                   const double         *pmDecl,
+                                   int                  first,
+                                   int                  last,
+                                   double               *raReturn,
+                                   double               *declReturn,
+                                   double               *altitudeReturn,
+                                   double               *azimuthReturn) {
+    const double (*m)[3] = frame->precessionNutation.m;
+    for (int k = first; k < last; k++) {
+        double cosRA = cos(raJ2000[k]);
+        double sinRA = sin(raJ2000[k]);
+        double cosDecl = cos(declJ2000[k]);
+        double sinDecl = sin(declJ2000[k]);
+        double x = cosDecl*cosRA;
+        double y = cosDecl*sinRA;
+        double z = sinDecl;
+        if (pmRA) {  // linear motion along the RA and decl unit vectors
+            double dRA = pmRA[k] * frame->yearsSinceJ2000;
+            double dDecl = pmDecl[k] * frame->yearsSinceJ2000;
+            x += -sinRA*dRA - sinDecl*cosRA*dDecl;
+            y +=  cosRA*dRA - sinDecl*sinRA*dDecl;
+            z +=  cosDecl*dDecl;
+        }
+        double xd = m[0][0]*x + m[0][1]*y + m[0][2]*z + frame->aberration[0];
+        double yd = m[1][0]*x + m[1][1]*y + m[1][2]*z + frame->aberration[1];
+        double zd = m[2][0]*x + m[2][1]*y + m[2][2]*z + frame->aberration[2];
+        double ra = atan2(yd, xd);
+        if (ra < 0) {
+            ra += M_PI * 2;
+        }
+        double rho = sqrt(xd*xd + yd*yd);
+        raReturn[k] = ra;
+        declReturn[k] = atan2(zd, rho);
+        if (altitudeReturn) {
+            // cos(decl)cos(H) and cos(decl)sin(H) for hour angle H = LST - RA; the vector needn't be normalized for atan2
+            double meridian = xd*frame->cosLST + yd*frame->sinLST;
+            double west = xd*frame->sinLST - yd*frame->cosLST;
+            double up = zd*frame->sinLatitude + meridian*frame->cosLatitude;
+            double north = zd*frame->cosLatitude - meridian*frame->sinLatitude;
+            altitudeReturn[k] = atan2(up, sqrt(north*north + west*west));
+            azimuthReturn[k] = atan2(-west, north);
+        }
+    }
+}
+
+#define kECCatalogueMinStarsPerThread 4096
+
+// Apparent positions (proper motion, P03 precession, WB nutation, annual aberration) for count catalogue stars given
+// as separate arrays.  Alt/az use the same sidereal time as planetAltAz so stars and planets line up on a sky map.
+// The per-instant work is done once here; the per-star work is split across threadCount threads (0 => one per core).
+void
+ECApparentPositionsForCatalogue(ESTimeInterval dateInterval,
+                                double         observerLatitude,
+                                double         observerLongitude,
+                                const double   *raJ2000,
+                                const double   *declJ2000,
+                                const double   *pmRA,
+                                const double   *pmDecl,
+                                int            count,
+                                double         *raReturn,
+                                double         *declReturn,
+                                double         *altitudeReturn,
+                                double         *azimuthReturn,
+                                int            threadCount) {
+    ESAssert(count >= 0);
+    ESAssert((pmRA == NULL) == (pmDecl == NULL));
+    ESAssert((altitudeReturn == NULL) == (azimuthReturn == NULL));
+    CatalogueFrame frame;
+    double julianCenturiesSince2000Epoch = julianCenturiesSince2000EpochForDateInterval(dateInterval, NULL, NULL);
+    ECPrecessionNutationMatrix(julianCenturiesSince2000Epoch, &frame.precessionNutation);
+    frame.yearsSinceJ2000 = julianCenturiesSince2000Epoch * 100;
+    double nutation;
+    double trueObliquity;
+    WB_nutationObliquity(julianCenturiesSince2000Epoch/100, &nutation, &trueObliquity, NULL);
+    earthVelocityOverC(julianCenturiesSince2000Epoch, trueObliquity, frame.aberration);
+    // See planetAltAz
+    if (observerLatitude > kECLimitingAzimuthLatitude) {
+        observerLatitude = kECLimitingAzimuthLatitude;
+    } else if (observerLatitude < - kECLimitingAzimuthLatitude) {
+        observerLatitude = - kECLimitingAzimuthLatitude;
+    }
+    double lst = convertGSTtoLST(convertUTToGSTP03(dateInterval, NULL), observerLongitude);
+    frame.cosLST = cos(lst);
+    frame.sinLST = sin(lst);
+    frame.cosLatitude = cos(observerLatitude);
+    frame.sinLatitude = sin(observerLatitude);
+
+    if (threadCount <= 0) {
+        threadCount = std::thread::hardware_concurrency();
+    }
+    int maxThreads = count / kECCatalogueMinStarsPerThread;
+    if (threadCount > maxThreads) {
+        threadCount = maxThreads;
+    }
+    if (threadCount <= 1) {
+        apparentPositionsForCatalogueRange(&frame, raJ2000, declJ2000, pmRA, pmDecl, 0, count,
+                                           raReturn, declReturn, altitudeReturn, azimuthReturn);
+        return;
+    }
+    std::vector<std::thread> workers;
+    workers.reserve(threadCount - 1);
+    int chunk = (count + threadCount - 1) / threadCount;
+    for (int first = chunk; first < count; first += chunk) {
+        int last = first + chunk < count ? first + chunk : count;
+        workers.push_back(std::thread(apparentPositionsForCatalogueRange, &frame, raJ2000, declJ2000, pmRA, pmDecl, first, last,
+                                      raReturn, declReturn, altitudeReturn, azimuthReturn));
+    }
+    apparentPositionsForCatalogueRange(&frame, raJ2000, declJ2000, pmRA, pmDecl, 0, chunk,
+                                       raReturn, declReturn, altitudeReturn, azimuthReturn);
+    for (size_t i = 0; i < workers.size(); i++) {
+        workers[i].join();
+    }
 }
 
 static void sunRAandDeclJ2000(ESTimeInterval dateInterval,
@@ -1008,7 +1427,7 @@ static void sunRAandDeclJ2000(ESTimeInterval dateInterval,
     double declOfDate;
     double sunLongitude;
     WB_sunRAAndDecl(julianCenturiesSince2000Epoch/100, &raOfDate, &declOfDate, &sunLongitude, _currentCache);
-    refineConvertToJ2000FromOfDate(julianCenturiesSince2000Epoch, raOfDate, declOfDate, rightAscensionReturn, declinationReturn);
+    convertToJ2000FromOfDate(julianCenturiesSince2000Epoch, raOfDate, declOfDate, rightAscensionReturn, declinationReturn, _currentCache);
     if (_currentCache) {
         _currentCache->cacheSlotValidFlag[sunRAJ2000SlotIndex] = _currentCache->currentFlag;
         _currentCache->cacheSlotValidFlag[sunDeclJ2000SlotIndex] = _currentCache->currentFlag;
@@ -1033,7 +1452,7 @@ static void moonRAandDeclJ2000(ESTimeInterval dateInterval,
     double moonEclipticLongitude;
     double moonEclipticLatitude;
     WB_MoonRAAndDecl(julianCenturiesSince2000Epoch, &raOfDate, &declOfDate, &moonEclipticLongitude, &moonEclipticLatitude, _currentCache, ECWBFullPrecision);
-    refineConvertToJ2000FromOfDate(julianCenturiesSince2000Epoch, raOfDate, declOfDate, rightAscensionReturn, declinationReturn);
+    convertToJ2000FromOfDate(julianCenturiesSince2000Epoch, raOfDate, declOfDate, rightAscensionReturn, declinationReturn, _currentCache);
     if (_currentCache) {
         _currentCache->cacheSlotValidFlag[moonRAJ2000SlotIndex] = _currentCache->currentFlag;
         _currentCache->cacheSlotValidFlag[moonDeclJ2000SlotIndex] = _currentCache->currentFlag;
@@ -1050,12 +1469,14 @@ testConvertJ2000() {
     double declJ2000 = 49.227750 * M_PI / 180;
     double raOfDate;
     double declOfDate;
-    convertJ2000ToOfDate(julianCenturiesSince2000Epoch, raJ2000, declJ2000, &raOfDate, &declOfDate);
+    ECRotationMatrix precession;
+    ECPrecessionMatrix(julianCenturiesSince2000Epoch, &precession);
+    ECRotateRADecl(&precession, false/*inverse*/, &raJ2000, &declJ2000, 1, &raOfDate, &declOfDate);
     //printAngle(raOfDate, "test convert RA");
     //printAngle(declOfDate, "test convert decl");
     double raOrig = raJ2000;
     double declOrig = declJ2000;
-    refineConvertToJ2000FromOfDate(julianCenturiesSince2000Epoch, raOfDate, declOfDate, &raJ2000, &declJ2000);
+    ECRotateRADecl(&precession, true/*inverse*/, &raOfDate, &declOfDate, 1, &raJ2000, &declJ2000);
     printf("And the results are:\n");
     printAngle(raOrig, "RA J2000 orig");
     printAngle(raJ2000, "RA J2000 round trip");
@@ -1064,6 +1485,68 @@ testConvertJ2000() {
 }
 #endif
 
+#ifndef NDEBUG
+static ESTimeInterval
+testUTDate(int    year,
+           int    month,
+           int    day,
+           int    hour,
+           int    minute,
+           double seconds) {
+    ESDateComponents cs;
+    cs.era = 1;
+    cs.year = year;
+    cs.month = month;
+    cs.day = day;
+    cs.hour = hour;
+    cs.minute = minute;
+    cs.seconds = seconds;
+    return ESCalendar_timeIntervalFromUTCDateComponents(&cs);
+}
+
+static void
+checkEclipseContact(ESTimeInterval contact,
+                    ESTimeInterval expected,
+                    const char     *description) {
+    printf("%s off by %.1f seconds\n", description, contact - expected);
+    ESAssert(fabs(contact - expected) < 4);
+}
+
+// Against Espenak & Meeus's Five Millennium Canon.  The Canon's 21st century has 224 solar eclipses and 228 lunar (86
+// penumbral, 57 partial, 85 total); it counts hybrid solar eclipses separately, and we call them total, so only the solar
+// total is checked.  The contacts are the Canon's times converted to UT with its delta-T, and agree to within 3 seconds.
+static void
+testFindEclipses() {
+    static ECEclipseEvent events[250];
+    int solarCount = ECFindEclipses(testUTDate(2001, 1, 1, 0, 0, 0), testUTDate(2101, 1, 1, 0, 0, 0), true, false, events, 250);
+    int lunarCount = ECFindEclipses(testUTDate(2001, 1, 1, 0, 0, 0), testUTDate(2101, 1, 1, 0, 0, 0), false, true, events, 250);
+    int lunarKindCounts[3] = { 0, 0, 0 };
+    for (int i = 0; i < lunarCount && i < 250; i++) {
+        lunarKindCounts[events[i].kind == ECEclipsePenumbralLunar ? 0 : events[i].kind == ECEclipsePartialLunar ? 1 : 2]++;
+    }
+    printf("2001-2100: %d solar eclipses, %d lunar (%d penumbral, %d partial, %d total)\n",
+           solarCount, lunarCount, lunarKindCounts[0], lunarKindCounts[1], lunarKindCounts[2]);
+    ESAssert(solarCount == 224);
+    ESAssert(lunarCount == 228);
+    ESAssert(lunarKindCounts[0] == 86 && lunarKindCounts[1] == 57 && lunarKindCounts[2] == 85);
+
+    ECEclipseEvent event;
+    int count = ECFindEclipses(testUTDate(2017, 8, 20, 0, 0, 0), testUTDate(2017, 8, 23, 0, 0, 0), true, false, &event, 1);
+    ESAssert(count == 1 && event.kind == ECEclipseTotalSolar);
+    checkEclipseContact(event.greatestEclipse, testUTDate(2017, 8, 21, 18, 25, 31), "2017 Aug 21 greatest eclipse");
+
+    count = ECFindEclipses(testUTDate(2018, 7, 26, 0, 0, 0), testUTDate(2018, 7, 29, 0, 0, 0), false, true, &event, 1);
+    ESAssert(count == 1 && event.kind == ECEclipseTotalLunar);
+    checkEclipseContact(event.penumbralStart, testUTDate(2018, 7, 27, 17, 14, 47), "2018 Jul 27 P1");
+    checkEclipseContact(event.umbralStart, testUTDate(2018, 7, 27, 18, 24, 27), "2018 Jul 27 U1");
+    checkEclipseContact(event.totalStart, testUTDate(2018, 7, 27, 19, 30, 15), "2018 Jul 27 U2");
+    checkEclipseContact(event.greatestEclipse, testUTDate(2018, 7, 27, 20, 21, 44), "2018 Jul 27 greatest eclipse");
+    checkEclipseContact(event.totalEnd, testUTDate(2018, 7, 27, 21, 13, 12), "2018 Jul 27 U3");
+    checkEclipseContact(event.umbralEnd, testUTDate(2018, 7, 27, 22, 19, 0), "2018 Jul 27 U4");
+    checkEclipseContact(event.penumbralEnd, testUTDate(2018, 7, 27, 23, 28, 38), "2018 Jul 27 P4");
+}
+#endif
+
 static double planetRadiiInAU[ECNumPlanets] = {
     695500  / kECAUInKilometers,  // ECPlanetSun       = 0
     1737.10 / kECAUInKilometers,  // ECPlanetMoon      = 1
@@ -2172,6 +2655,9 @@ ESAstronomyManager::runTests () {
     double pa = positionAngle(ra, decl, moonRA, moonDecl);
     printAngle(pa, "position angle");
 
+    printf("\nEclipses\n");
+    testFindEclipses();
+
     printf("\n\n");
     printingEnabled = false;
 #endif
@@ -2200,7 +2686,7 @@ ESAstronomyManager::setupLocalEnvironmentForThreadFromActionButton(bool
         ESAssert(!_watchTime || _watchTime->currentTime() == _calculationDateInterval);
         ESAssert(_currentCache);
         if (_currentCache && fabs(_currentCache->dateInterval - _calculationDateInterval) > ASTRO_SLOP) {
-            pushECAstroCacheInPool(_astroCachePool, &_astroCachePool->finalCache, _calculationDateInterval);
+            pushFinalCacheInPool(_astroCachePool, _calculationDateInterval);
         }
         ESAssert(fabs(_currentCache->dateInterval - _calculationDateInterval) <= ASTRO_SLOP);
         //printf("...exiting early\n");
@@ -4516,7 +5002,7 @@ ESAstronomyManager::moonAscendingNodeRAJ2000 () {
             raOfDate += 2 * M_PI;
         }
         double decl;
-        refineConvertToJ2000FromOfDate(julianCenturiesSince2000Epoch, raOfDate, declOfDate, &RA, &decl);
+        convertToJ2000FromOfDate(julianCenturiesSince2000Epoch, raOfDate, declOfDate, &RA, &decl, _currentCache);
         //printAngle(longitude, "ascending node longitude");
         //printAngle(RA, "ascending node RA");
         if (_currentCache) {
@@ -4590,6 +5076,8 @@ static const char *nameOfEclipseKind(ECEclipseKind kind) {
         return "ECEclipsePartialLunar";
       case ECEclipseTotalLunar:
         return "ECEclipseTotalLunar";
+      case ECEclipsePenumbralLunar:
+        return "ECEclipsePenumbralLunar";
       default:
         return "Bogus EclipseKind";
     }
@@ -4739,6 +5227,245 @@ calculateEclipse(ESTimeInterval _calculationDateInterval,
     }
 }
 
+// Geocentric circumstances of an eclipse at one instant:  the separation of the Moon from the Sun (solar) or from the
+// axis of the Earth's shadow (lunar), and the separations at which each kind of contact occurs.  For solar eclipses the
+// Moon's parallax less the Sun's is how far an observer on the Earth can displace the Moon against the Sun, so adding it
+// to the usual contact separations gives the contacts for the Earth as a whole (ignoring the Earth's flattening).
+namespace {
+struct EclipseGeometry {
+    double separation;
+    double penumbralContact;
+    double umbralContact;
+    double totalContact;      // Lunar only; negative if the Moon can't fit inside the umbra
+    double moonRadius;
+    double sunRadius;
+    double moonParallax;
+    double shadowRadius;      // Lunar: umbra; solar: Moon's parallax less the Sun's
+    double penumbralRadius;   // Lunar only
+};
+}
+
+static void
+eclipseGeometryForDate(ESTimeInterval  dateInterval,
+                       bool            solarNotLunar,
+                       EclipseGeometry *geometry) {
+    double julianCenturiesSince2000Epoch = julianCenturiesSince2000EpochForDateInterval(dateInterval, NULL, NULL);
+    double sunRightAscension;
+    double sunDeclination;
+    double sunEclipticLongitude;
+    double sunEclipticLatitude;
+    double sunGeocentricDistance;
+    WB_planetApparentPosition(ECPlanetSun, julianCenturiesSince2000Epoch/100, &sunEclipticLongitude, &sunEclipticLatitude, &sunGeocentricDistance, &sunRightAscension, &sunDeclination, NULL, ECWBFullPrecision);
+    double sunAngularSize;
+    double sunParallax;
+    planetSizeAndParallax(ECPlanetSun, sunGeocentricDistance, &sunAngularSize, &sunParallax);
+    double moonRightAscension;
+    double moonDeclination;
+    double moonEclipticLongitude;
+    double moonEclipticLatitude;
+    double moonGeocentricDistance;
+    WB_planetApparentPosition(ECPlanetMoon, julianCenturiesSince2000Epoch/100, &moonEclipticLongitude, &moonEclipticLatitude, &moonGeocentricDistance, &moonRightAscension, &moonDeclination, NULL, ECWBFullPrecision);
+    double moonAngularSize;
+    double moonParallax;
+    planetSizeAndParallax(ECPlanetMoon, moonGeocentricDistance, &moonAngularSize, &moonParallax);
+    geometry->moonRadius = moonAngularSize / 2;
+    geometry->sunRadius = sunAngularSize / 2;
+    geometry->moonParallax = moonParallax;
+    if (solarNotLunar) {
+        geometry->separation = angularSeparation(sunRightAscension, sunDeclination, moonRightAscension, moonDeclination);
+        geometry->shadowRadius = moonParallax - sunParallax;
+        geometry->penumbralRadius = 0;
+        geometry->penumbralContact = geometry->shadowRadius + geometry->sunRadius + geometry->moonRadius;
+        geometry->umbralContact = geometry->shadowRadius + fabs(geometry->moonRadius - geometry->sunRadius);
+        geometry->totalContact = -1;
+    } else {
+        geometry->separation = angularSeparation(sunRightAscension + M_PI, -sunDeclination, moonRightAscension, moonDeclination);
+        geometry->shadowRadius = umbralAngularRadius(moonParallax, geometry->sunRadius, sunParallax);
+        geometry->penumbralRadius = 1.01 * moonParallax + geometry->sunRadius + sunParallax;
+        geometry->penumbralContact = geometry->penumbralRadius + geometry->moonRadius;
+        geometry->umbralContact = geometry->shadowRadius + geometry->moonRadius;
+        geometry->totalContact = geometry->shadowRadius - geometry->moonRadius;
+    }
+}
+
+static double
+eclipseSeparationAtDate(ESTimeInterval dateInterval,
+                        bool           solarNotLunar) {
+    EclipseGeometry geometry;
+    eclipseGeometryForDate(dateInterval, solarNotLunar, &geometry);
+    return geometry.separation;
+}
+
+// Over a few hours the Moon moves nearly uniformly along a straight line relative to the Sun or the shadow, so the
+// square of the separation is very nearly a parabola in time; jump to the parabola's vertex until it stops moving.
+// Returns the relative angular speed (radians per second) found by the last fit.
+static double
+refineGreatestEclipse(ESTimeInterval *dateInterval,
+                      bool           solarNotLunar) {
+    ESTimeInterval t = *dateInterval;
+    double step = 3600;
+    double speedSquared = 0;
+    for (int i = 0; i < 10; i++) {
+        double before = eclipseSeparationAtDate(t - step, solarNotLunar);
+        double middle = eclipseSeparationAtDate(t, solarNotLunar);
+        double after = eclipseSeparationAtDate(t + step, solarNotLunar);
+        before *= before;
+        middle *= middle;
+        after *= after;
+        double curvature = (before - 2 * middle + after) / (2 * step * step);
+        if (curvature <= 0) {  // Shouldn't happen near a syzygy; take the smallest sample and carry on
+            t += before < after ? -step : step;
+            continue;
+        }
+        speedSquared = curvature;
+        double offset = -(after - before) / (2 * step) / (2 * curvature);
+        t += offset;
+        if (fabs(offset) < 0.5) {
+            break;
+        }
+        step = fmin(fmax(fabs(offset), 60), 3600);
+    }
+    *dateInterval = t;
+    return sqrt(speedSquared);
+}
+
+// The time at which the separation crosses the contact separation chosen by contactOffset, on the side of greatest
+// eclipse given by direction (-1 before, +1 after), or NAN if it never gets that close
+static ESTimeInterval
+refineEclipseContact(ESTimeInterval        greatestEclipse,
+                     const EclipseGeometry &atGreatest,
+                     double                EclipseGeometry::*contactOffset,
+                     double                relativeSpeed,
+                     int                   direction,
+                     bool                  solarNotLunar) {
+    double contact = atGreatest.*contactOffset;
+    if (contact <= atGreatest.separation || relativeSpeed <= 0) {
+        return nan("");
+    }
+    ESTimeInterval t0 = greatestEclipse + direction * sqrt(contact * contact - atGreatest.separation * atGreatest.separation) / relativeSpeed;
+    ESTimeInterval t1 = t0 + direction * 60;
+    EclipseGeometry geometry;
+    eclipseGeometryForDate(t0, solarNotLunar, &geometry);
+    double f0 = geometry.separation - geometry.*contactOffset;
+    for (int i = 0; i < 10; i++) {
+        eclipseGeometryForDate(t1, solarNotLunar, &geometry);
+        double f1 = geometry.separation - geometry.*contactOffset;
+        if (f1 == f0) {
+            break;
+        }
+        ESTimeInterval t2 = t1 - f1 * (t1 - t0) / (f1 - f0);
+        t0 = t1;
+        f0 = f1;
+        t1 = t2;
+        if (fabs(t1 - t0) < 0.5) {
+            break;
+        }
+    }
+    return t1;
+}
+
+// Fills in the eclipse, if any, at the syzygy near the given date; returns false if there isn't one
+static bool
+eclipseNearSyzygy(ESTimeInterval approximateDate,
+                  bool           solarNotLunar,
+                  ECEclipseEvent *event) {
+    ESTimeInterval syzygy = approximateDate;
+    for (int i = 0; i < 2; i++) {
+        syzygy = stepRefineMoonAgeTargetForDate(syzygy, solarNotLunar ? 0 : M_PI, NULL);
+    }
+    ESTimeInterval greatestEclipse = syzygy;
+    double relativeSpeed = refineGreatestEclipse(&greatestEclipse, solarNotLunar);
+    EclipseGeometry geometry;
+    eclipseGeometryForDate(greatestEclipse, solarNotLunar, &geometry);
+    if (geometry.separation >= geometry.penumbralContact) {
+        return false;
+    }
+    event->greatestEclipse = greatestEclipse;
+    event->minimumSeparation = geometry.separation;
+    event->penumbralStart = refineEclipseContact(greatestEclipse, geometry, &EclipseGeometry::penumbralContact, relativeSpeed, -1, solarNotLunar);
+    event->penumbralEnd = refineEclipseContact(greatestEclipse, geometry, &EclipseGeometry::penumbralContact, relativeSpeed, 1, solarNotLunar);
+    event->umbralStart = refineEclipseContact(greatestEclipse, geometry, &EclipseGeometry::umbralContact, relativeSpeed, -1, solarNotLunar);
+    event->umbralEnd = refineEclipseContact(greatestEclipse, geometry, &EclipseGeometry::umbralContact, relativeSpeed, 1, solarNotLunar);
+    event->totalStart = refineEclipseContact(greatestEclipse, geometry, &EclipseGeometry::totalContact, relativeSpeed, -1, solarNotLunar);
+    event->totalEnd = refineEclipseContact(greatestEclipse, geometry, &EclipseGeometry::totalContact, relativeSpeed, 1, solarNotLunar);
+    if (solarNotLunar) {
+        // Whether a central eclipse is total or annular is decided where the Moon is closest, nearest the sub-lunar
+        // point, where it appears larger than from the Earth's center by about 1/(1 - sin parallax).  Hybrid eclipses
+        // thus come out total.
+        double nearMoonRadius = geometry.moonRadius / (1 - sin(geometry.moonParallax));
+        if (geometry.separation < geometry.umbralContact) {
+            event->kind = nearMoonRadius > geometry.sunRadius ? ECEclipseTotalSolar : ECEclipseAnnularSolar;
+            event->magnitude = nearMoonRadius / geometry.sunRadius;
+        } else {
+            event->kind = ECEclipsePartialSolar;
+            event->magnitude = (geometry.sunRadius + geometry.moonRadius - (geometry.separation - geometry.shadowRadius)) / (2 * geometry.sunRadius);
+        }
+    } else {
+        if (geometry.separation < geometry.totalContact) {
+            event->kind = ECEclipseTotalLunar;
+        } else if (geometry.separation < geometry.umbralContact) {
+            event->kind = ECEclipsePartialLunar;
+        } else {
+            event->kind = ECEclipsePenumbralLunar;
+        }
+        if (event->kind == ECEclipsePenumbralLunar) {
+            event->magnitude = (geometry.penumbralContact - geometry.separation) / (2 * geometry.moonRadius);
+        } else {
+            event->magnitude = (geometry.umbralContact - geometry.separation) / (2 * geometry.moonRadius);
+        }
+    }
+    return true;
+}
+
+// Rather than stepping through time, visit each mean new and full moon (Meeus, Astronomical Algorithms, ch. 49 and 54),
+// skip the ones too far from a lunar node for any eclipse, and refine only the remaining ~10% of syzygies.  The limit on
+// |sin(Sun's longitude - node)| is a little looser than Meeus's 0.36 since we use the true Sun but the mean node, which
+// can be 1.5 degrees off.
+#define kECMeanNewMoonJD2000 (2451550.09766)   // JDE of the mean new moon of 6 Jan 2000 (lunation 0)
+#define kECMeanSynodicMonthDays (29.530588861)
+#define kECEclipseNodeLimitSine (0.40)
+
+int
+ECFindEclipses(ESTimeInterval startDate,
+               ESTimeInterval endDate,
+               bool           wantSolar,
+               bool           wantLunar,
+               ECEclipseEvent *eventsReturn,
+               int            maxEvents) {
+    ESAssert(maxEvents == 0 || eventsReturn);
+    // A syzygy can be half a day from the mean one, and greatest eclipse a few hours from the syzygy
+    double margin = kECLunarCycleInSeconds / 2;
+    ESTimeInterval meanNewMoonAtLunation0 = (kECMeanNewMoonJD2000 - kECJulianDateOf1990Epoch) * 24 * 3600 + kEC1990Epoch;  // TDT, close enough
+    double secondsPerLunation = kECMeanSynodicMonthDays * 24 * 3600;
+    int firstLunation = (int)floor((startDate - margin - meanNewMoonAtLunation0) / secondsPerLunation);
+    int lastLunation = (int)ceil((endDate + margin - meanNewMoonAtLunation0) / secondsPerLunation);
+    int eventCount = 0;
+    for (int lunation = firstLunation; lunation <= lastLunation; lunation++) {
+        for (int half = 0; half < 2; half++) {
+            bool solarNotLunar = half == 0;
+            if (solarNotLunar ? !wantSolar : !wantLunar) {
+                continue;
+            }
+            ESTimeInterval meanSyzygy = meanNewMoonAtLunation0 + (lunation + half * 0.5) * secondsPerLunation;
+            double julianCenturiesSince2000Epoch = julianCenturiesSince2000EpochForDateInterval(meanSyzygy, NULL, NULL);
+            double sunLongitude = WB_sunLongitudeApparent(julianCenturiesSince2000Epoch/100, NULL);
+            double nodeLongitude = WB_MoonAscendingNodeLongitude(julianCenturiesSince2000Epoch, NULL);
+            if (fabs(sin(sunLongitude - nodeLongitude)) > kECEclipseNodeLimitSine) {
+                continue;
+            }
+            ECEclipseEvent event;
+            if (eclipseNearSyzygy(meanSyzygy, solarNotLunar, &event)
+                && event.greatestEclipse >= startDate && event.greatestEclipse < endDate) {
+                if (eventCount < maxEvents) {
+                    eventsReturn[eventCount] = event;
+                }
+                eventCount++;
+            }
+        }
+    }
+    return eventCount;
+}
+
 // Separation of Sun from Moon, or Earth's shadow from Moon, scaled such that
 //   1) partial eclipse starts when separation == 2
 //   2) total eclipse starts when separation == 1
@@ -4813,6 +5540,8 @@ ESAstronomyManager::eclipseKindIsMoreSolarThanLunar(ECEclipseKind eclipseKind) {
         return false;
       case ECEclipseTotalLunar:
         return false;
+      case ECEclipsePenumbralLunar:
+        return false;
       default:
         ESAssert(false);
         return false;
@@ -420,4 +420,124 @@ extern void
 EC_printAngle(double     angle,
 	      const char *description);
 
+// Delta-T (TDT - UT), in seconds, for a year value as in 2008.5 for July 1.  From -500 through 2150 the value comes
+// from a precomputed spline which follows the model to within 1 ms, including its steps between eras, except for up
+// to 0.09 s of smoothing across the Meeus table (1620-2004)
+typedef enum ECDeltaTModel {
+    ECDeltaTEspenak   = 0,  // Espenak & Meeus polynomials (the default)
+    ECDeltaTMeeus     = 1,  // Meeus 2nd ed table and formulas
+    ECNumDeltaTModels = 2
+} ECDeltaTModel;
+extern double
+ECDeltaT(double        yearValue,
+         ECDeltaTModel model);
+extern void
+ECDeltaTBatch(const double  *yearValues,
+              int           count,
+              ECDeltaTModel model,
+              double        *deltaTReturn);
+// The model used for all TDT calculations; set it before using any astro cache, since cached values don't record it
+extern void
+ECSetDeltaTModel(ECDeltaTModel model);
+extern ECDeltaTModel
+ECGetDeltaTModel();
+
+// A rotation between equatorial frames, applied to unit column vectors (x toward the equinox, z toward the pole)
+typedef struct ECRotationMatrix {
+    double m[3][3];
+} ECRotationMatrix;
+// J2000 mean equator and equinox to mean equator and equinox of date (P03 precession)
+extern void
+ECPrecessionMatrix(double           julianCenturiesSince2000Epoch,
+                   ECRotationMatrix *matrixReturn);
+// J2000 mean equator and equinox to true equator and equinox of date (P03 precession, WB nutation)
+extern void
+ECPrecessionNutationMatrix(double           julianCenturiesSince2000Epoch,
+                           ECRotationMatrix *matrixReturn);
+// Rotate count vectors held in separate x/y/z arrays; inverse applies the transpose.  The returns may alias the inputs
+extern void
+ECRotateVectors(const ECRotationMatrix *matrix,
+                bool                   inverse,
+                const double           *x,
+                const double           *y,
+                const double           *z,
+                int                    count,
+                double                 *xReturn,
+                double                 *yReturn,
+                double                 *zReturn);
+// Same for RA/decl pairs in radians; RA is returned in [0, 2pi)
+extern void
+ECRotateRADecl(const ECRotationMatrix *matrix,
+               bool                   inverse,
+               const double           *ra,
+               const double           *decl,
+               int                    count,
+               double                 *raReturn,
+               double                 *declReturn);
+// Apparent RA/decl of date (and, if altitudeReturn and azimuthReturn are non-NULL, alt/az for the observer) for count
+// stars given as separate J2000 arrays.  Radians throughout; proper motions are in radians per Julian year, with pmRA
+// already multiplied by cos(decl), and may both be NULL.  threadCount 0 means one thread per core.
+extern void
+ECApparentPositionsForCatalogue(ESTimeInterval dateInterval,
+                                double         observerLatitude,
+                                double         observerLongitude,
+                                const double   *raJ2000,
+                                const double   *declJ2000,
+                                const double   *pmRA,
+                                const double   *pmDecl,
+                                int            count,
+                                double         *raReturn,
+                                double         *declReturn,
+                                double         *altitudeReturn,
+                                double         *azimuthReturn,
+                                int            threadCount);
+// Greenwich mean sidereal time, in radians in [0, 2pi), for count UT instants (as used for planet alt/az).  Each instant
+// gets its own delta-T, so the instants may span any range of dates; results are within 1E-6 seconds of the one-at-a-time code
+extern void
+ECGreenwichSiderealTimeBatch(const ESTimeInterval *dateIntervals,
+                             int                  count,
+                             double               *gstReturn);
+// Local sidereal time for every instant and longitude (east positive, radians):  lstReturn[i*longitudeCount + j] is for
+// dateIntervals[i] at observerLongitudes[j], so lstReturn needs count*longitudeCount entries
+extern void
+ECLocalSiderealTimeBatch(const ESTimeInterval *dateIntervals,
+                         int                  count,
+                         const double         *observerLongitudes,
+                         int                  longitudeCount,
+                         double               *lstReturn);
+// For each i, the UT within half a sidereal day of closestToTheseDates[i] at which GMST is gsts[i] (radians)
+extern void
+ECConvertGSTToUTClosestBatch(const double         *gsts,
+                             const ESTimeInterval *closestToTheseDates,
+                             int                  count,
+                             ESTimeInterval       *utReturn);
+
+// One eclipse as seen from anywhere on the Earth.  Contacts are UT and are NAN when the eclipse doesn't have them:
+// for a lunar eclipse, penumbral/umbral/total start and end are P1/U1/U2 and U3/U4/P4; for a solar eclipse, penumbral
+// start and end are the first and last contact of the penumbra with the Earth, umbral start and end the same for the
+// umbra (or antumbra) when it reaches the Earth at all, and there are no total contacts.
+typedef struct ECEclipseEvent {
+    ECEclipseKind  kind;                 // ECEclipsePartialSolar, ECEclipseAnnularSolar, ECEclipseTotalSolar,
+                                         // ECEclipsePenumbralLunar, ECEclipsePartialLunar or ECEclipseTotalLunar
+    ESTimeInterval greatestEclipse;      // Closest geocentric approach of the Moon to the Sun or to the shadow axis
+    ESTimeInterval penumbralStart;
+    ESTimeInterval umbralStart;
+    ESTimeInterval totalStart;
+    ESTimeInterval totalEnd;
+    ESTimeInterval umbralEnd;
+    ESTimeInterval penumbralEnd;
+    double         minimumSeparation;    // Radians, at greatest eclipse
+    double         magnitude;            // Lunar: umbral magnitude (penumbral for penumbral eclipses); solar: greatest
+                                         // fraction of the Sun's diameter covered, or diameter ratio when central
+} ECEclipseEvent;
+// Every solar and/or lunar eclipse whose greatest eclipse lies in [startDate, endDate), in order.  Fills at most
+// maxEvents entries of eventsReturn (which may be NULL if maxEvents is 0) and returns the total number found.
+extern int
+ECFindEclipses(ESTimeInterval startDate,
+               ESTimeInterval endDate,
+               bool           wantSolar,
+               bool           wantLunar,
+               ECEclipseEvent *eventsReturn,
+               int            maxEvents);
+
 #endif // _ESASTRONOMY_HPP_
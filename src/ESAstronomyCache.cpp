@@ -20,48 +20,202 @@
 #endif
 
 #include <math.h>
+#include <string.h>
+#include <atomic>
 
 static ECAstroCachePool astroCachePools[2];  // By entry thread# into ECAstronomy (if location, time zone, or calculation dates are different; see reserveCachePool)
 
-static void bumpValidFlagsForLocationIndependentSlotsWithFlagValue(ECAstroCache *cache,
-                                                                   int          oldGlobalFlag) {
-    unsigned int *p = cache->cacheSlotValidFlag;
-    unsigned int *end = p + firstLocationDependentSlotIndex;
-    while (p < end) {
-        if (*p == oldGlobalFlag) {
-            (*p)++;
-        }
-        p++;
+// Process-wide table of location-independent slot values.  Each entry is published with a sequence lock:  the sequence is odd
+// while a writer is updating the entry, and a reader accepts what it copied only if the sequence was even and unchanged throughout.
+// The payload fields are relaxed atomics so that a reader racing a writer reads garbage it then discards rather than
+// invoking undefined behavior; the fences around the payload accesses order them against the sequence.
+#define ECNumSharedCacheEntries 64
+
+typedef struct _ECSharedAstroCacheEntry {
+    std::atomic<unsigned int>   sequence;
+    std::atomic<unsigned int>   generation;  // to test against sharedCacheGeneration; bumped by clearAllCaches
+    std::atomic<long long>      bucket;
+    std::atomic<ESTimeInterval> dateInterval;
+    std::atomic<bool>           runningBackward;
+    std::atomic<int>            numValidSlots;
+    std::atomic<bool>           slotValid[firstLocationDependentSlotIndex];
+    std::atomic<double>         slots[firstLocationDependentSlotIndex];
+} ECSharedAstroCacheEntry;  // about 70k bytes for the whole table
+
+static ECSharedAstroCacheEntry sharedCacheEntries[ECNumSharedCacheEntries];
+static std::atomic<unsigned int> sharedCacheGeneration(1);
+
+// The shared table buckets dates by the Default slop group's slop; returns false if sharing is off because that slop is zero
+static bool sharedCacheBucketForDate(ESTimeInterval dateInterval,
+				     long long      *bucket) {
+    ESTimeInterval slop = slopForSlopGroup(ECSlopGroupDefault);
+    if (slop <= 0) {
+	return false;
+    }
+    *bucket = (long long)floor(dateInterval / slop);
+    return true;
+}
+
+static ECSharedAstroCacheEntry *sharedCacheEntryForBucket(long long bucket) {
+    int index = (int)(bucket % ECNumSharedCacheEntries);
+    if (index < 0) {
+	index += ECNumSharedCacheEntries;
+    }
+    return &sharedCacheEntries[index];
+}
+
+static unsigned char cacheSlotDependencies[numCacheSlots];
+
+static void setDependenciesForSlots(int          firstSlotIndex,
+				    int          numSlots,
+				    unsigned int dependencies) {
+    for (int i = firstSlotIndex; i < firstSlotIndex + numSlots; i++) {
+	cacheSlotDependencies[i] = dependencies;
+    }
+}
+
+static void addDependenciesForSlots(int          firstSlotIndex,
+				    int          numSlots,
+				    unsigned int dependencies) {
+    for (int i = firstSlotIndex; i < firstSlotIndex + numSlots; i++) {
+	cacheSlotDependencies[i] |= dependencies;
     }
 }
 
-// Once we've reserved a cache pool, set up all of the caches in that cache pool with the right parameters, bumping up the global flag
-// if we don't match the cache in use
+#define PLANET_SLOTS(slotIndex) slotIndex, 10  // slotIndex through slotIndex9 (up to Neptune)
+
+static void setupCacheSlotDependencies() {
+    // By default, everything depends on time, and everything in the location-dependent section depends on lat/long and tz (as it always has)
+    setDependenciesForSlots(0, firstLocationDependentSlotIndex, ECSlotDependsOnTime);
+    setDependenciesForSlots(firstLocationDependentSlotIndex, numCacheSlots - firstLocationDependentSlotIndex,
+			    ECSlotDependsOnTime | ECSlotDependsOnLocation | ECSlotDependsOnTZOffset);
+
+    // Location-dependent slots which don't care about the time zone
+    setDependenciesForSlots(moonRelativePositionAngleSlotIndex, longitudeOfEclipticMeridianSlotIndex - moonRelativePositionAngleSlotIndex + 1,
+			    ECSlotDependsOnTime | ECSlotDependsOnLocation);  // moon relative angles, sun/moon alt/az, ecliptic geometry
+    setDependenciesForSlots(lstSlotIndex, eclipseKindSlotIndex - lstSlotIndex + 1, ECSlotDependsOnTime | ECSlotDependsOnLocation);
+    setDependenciesForSlots(PLANET_SLOTS(planetIsUpSlotIndex), ECSlotDependsOnTime | ECSlotDependsOnLocation);
+    setDependenciesForSlots(PLANET_SLOTS(dayNightMasterRiseAngleLSTSlotIndex), ECSlotDependsOnTime | ECSlotDependsOnLocation);
+    setDependenciesForSlots(PLANET_SLOTS(dayNightMasterSetAngleLSTSlotIndex), ECSlotDependsOnTime | ECSlotDependsOnLocation);
+    setDependenciesForSlots(PLANET_SLOTS(dayNightMasterRTransitAngleLSTSlotIndex), ECSlotDependsOnTime | ECSlotDependsOnLocation);
+    setDependenciesForSlots(PLANET_SLOTS(dayNightMasterSTransitAngleLSTSlotIndex), ECSlotDependsOnTime | ECSlotDependsOnLocation);
+    setDependenciesForSlots(PLANET_SLOTS(planetAltitudeSlotIndex), ECSlotDependsOnTime | ECSlotDependsOnLocation);
+    setDependenciesForSlots(PLANET_SLOTS(planetAzimuthSlotIndex), ECSlotDependsOnTime | ECSlotDependsOnLocation);
+    setDependenciesForSlots(PLANET_SLOTS(planetRATopoSlotIndex), ECSlotDependsOnTime | ECSlotDependsOnLocation);
+    setDependenciesForSlots(PLANET_SLOTS(planetDeclTopoSlotIndex), ECSlotDependsOnTime | ECSlotDependsOnLocation);
+
+    // Slots in the location-dependent section which actually are geocentric
+    setDependenciesForSlots(PLANET_SLOTS(planetRASlotIndex), ECSlotDependsOnTime);
+    setDependenciesForSlots(PLANET_SLOTS(planetDeclSlotIndex), ECSlotDependsOnTime);
+
+    // The year indicator is in local time
+    addDependenciesForSlots(closestSunEclipticLongIndicatorAngleSlotIndex, 4, ECSlotDependsOnTZOffset);
+
+    // Next/prev values flip when running backward
+    addDependenciesForSlots(nextMoonPhaseSlotIndex, 2, ECSlotDependsOnDirection);  // next and prev
+    addDependenciesForSlots(closestNewMoonSlotIndex, 4, ECSlotDependsOnDirection);
+    addDependenciesForSlots(nextNewMoonSlotIndex, 4, ECSlotDependsOnDirection);
+    addDependenciesForSlots(nextSunriseSlotIndex, nextMoontransitSlotIndex - nextSunriseSlotIndex + 1, ECSlotDependsOnDirection);
+    addDependenciesForSlots(PLANET_SLOTS(nextPlanetriseSlotIndex), ECSlotDependsOnDirection);
+    addDependenciesForSlots(PLANET_SLOTS(nextPlanetsetSlotIndex), ECSlotDependsOnDirection);
+    addDependenciesForSlots(PLANET_SLOTS(nextPlanettransitSlotIndex), ECSlotDependsOnDirection);
+    addDependenciesForSlots(PLANET_SLOTS(nextPlanettransitLowSlotIndex), ECSlotDependsOnDirection);
+    addDependenciesForSlots(PLANET_SLOTS(prevPlanetriseSlotIndex), ECSlotDependsOnDirection);
+    addDependenciesForSlots(PLANET_SLOTS(prevPlanetsetSlotIndex), ECSlotDependsOnDirection);
+    addDependenciesForSlots(PLANET_SLOTS(prevPlanettransitSlotIndex), ECSlotDependsOnDirection);
+    addDependenciesForSlots(PLANET_SLOTS(prevPlanettransitLowSlotIndex), ECSlotDependsOnDirection);
+
+    // Slots which come in per-precision flavors
+    addDependenciesForSlots(WBLunarLongitudeLowSlotIndex, WBMoonDistanceFullSlotIndex - WBLunarLongitudeLowSlotIndex + 1, ECSlotDependsOnPrecision);
+    addDependenciesForSlots(PLANET_SLOTS(nextPlanettransitLowSlotIndex), ECSlotDependsOnPrecision);
+    addDependenciesForSlots(PLANET_SLOTS(prevPlanettransitLowSlotIndex), ECSlotDependsOnPrecision);
+}
+
+#undef PLANET_SLOTS
+
+unsigned int dependenciesForCacheSlot(int slotIndex) {
+    ESAssert(slotIndex >= 0 && slotIndex < numCacheSlots);
+    return cacheSlotDependencies[slotIndex];
+}
+
+static unsigned char cacheSlotSlopGroups[numCacheSlots];
+
+static ESTimeInterval slopGroupSlops[ECNumSlopGroups] = {
+    ASTRO_SLOP_RAW,  // ECSlopGroupDefault
+    ASTRO_SLOP_RAW,  // ECSlopGroupAltAz
+    3600             // ECSlopGroupSlowlyVarying
+};
+
+// Fastest angular rate of anything in each group, in arcseconds per second, for setAccuracyTargetForSlopGroup
+static const double slopGroupMaxRates[ECNumSlopGroups] = {
+    0.6,     // ECSlopGroupDefault:        the Moon's motion against the stars (~13 degrees/day), plus a little
+    15.1,    // ECSlopGroupAltAz:          sidereal rotation
+    1.6E-6   // ECSlopGroupSlowlyVarying:  general precession, 50.3 arcseconds/year
+};
+
+static void setSlopGroupForSlots(int         firstSlotIndex,
+				 int         numSlots,
+				 ECSlopGroup slopGroup) {
+    for (int i = firstSlotIndex; i < firstSlotIndex + numSlots; i++) {
+	cacheSlotSlopGroups[i] = slopGroup;
+    }
+}
+
+static void setupCacheSlotSlopGroups() {
+    setSlopGroupForSlots(0, numCacheSlots, ECSlopGroupDefault);
+
+    setSlopGroupForSlots(sunAltitudeSlotIndex, 4, ECSlopGroupAltAz);  // sun & moon alt/az
+    setSlopGroupForSlots(planetAltitudeSlotIndex, 10, ECSlopGroupAltAz);
+    setSlopGroupForSlots(planetAzimuthSlotIndex, 10, ECSlopGroupAltAz);
+
+    setSlopGroupForSlots(precessionSlotIndex, 1, ECSlopGroupSlowlyVarying);
+    setSlopGroupForSlots(precessionMatrixSlotIndex, 9, ECSlopGroupSlowlyVarying);
+    setSlopGroupForSlots(calendarErrorSlotIndex, 1, ECSlopGroupSlowlyVarying);
+}
+
+ECSlopGroup slopGroupForCacheSlot(int slotIndex) {
+    ESAssert(slotIndex >= 0 && slotIndex < numCacheSlots);
+    return (ECSlopGroup)cacheSlotSlopGroups[slotIndex];
+}
+
+ESTimeInterval slopForSlopGroup(ECSlopGroup slopGroup) {
+    ESAssert(slopGroup >= 0 && slopGroup < ECNumSlopGroups);
+    return slopGroupSlops[slopGroup];
+}
+
+void setSlopForSlopGroup(ECSlopGroup    slopGroup,
+			 ESTimeInterval slop) {
+    ESAssert(slopGroup >= 0 && slopGroup < ECNumSlopGroups);
+    ESAssert(slop >= 0);
+    slopGroupSlops[slopGroup] = slop;
+}
+
+void setAccuracyTargetForSlopGroup(ECSlopGroup slopGroup,
+				   double      arcseconds) {
+    ESAssert(slopGroup >= 0 && slopGroup < ECNumSlopGroups);
+    setSlopForSlopGroup(slopGroup, arcseconds / slopGroupMaxRates[slopGroup]);
+}
+
+// The slop in effect for the given group when a cache is pushed with the given (default-group) slop
+static ESTimeInterval effectiveSlopForSlopGroup(int            slopGroup,
+						ESTimeInterval slop) {
+    if (slopGroup == ECSlopGroupDefault || slop == 0) {
+	return slop;
+    }
+    return slopGroupSlops[slopGroup];
+}
+
+// Once we've reserved a cache pool, record the observer parameters in it.  Each cache compares these against the
+// parameters it was filled with when it is next pushed (see invalidateSlotsForObserverChanges)
 void setupGlobalCacheFlag(ECAstroCachePool *cachePool,
 			  double 	   observerLatitude,
 			  double 	   observerLongitude,
 			  bool   	   runningBackward,
 			  int              tzOffsetSeconds) {
-    if (runningBackward != cachePool->runningBackward) {
-        // If the time parameters have changed then we gotta redo the cache no matter what
-	cachePool->runningBackward = runningBackward;
-	cachePool->currentGlobalCacheFlag++;
-    } else if (tzOffsetSeconds != cachePool->tzOffsetSeconds ||
-               observerLatitude != cachePool->observerLatitude ||
-               observerLongitude != cachePool->observerLongitude) {
-        // But if only the location parameters have changed, we only need to invalidate the location-dependent slots.
-        // We do this by bumping the global flag, then comparing each location-independent slot with the global flag,
-        // and if the slot was valid before, we bump it now since all that's changed is the location.
-	cachePool->observerLatitude = observerLatitude;
-	cachePool->observerLongitude = observerLongitude;
-	cachePool->tzOffsetSeconds = tzOffsetSeconds;
-        unsigned int oldGlobalFlag = cachePool->currentGlobalCacheFlag++;
-        bumpValidFlagsForLocationIndependentSlotsWithFlagValue(&cachePool->finalCache, oldGlobalFlag);
-//        bumpValidFlagsForLocationIndependentSlotsWithFlagValue(&cachePool->tempCache, oldGlobalFlag);        // temp cache never matches global time anyway
-//        bumpValidFlagsForLocationIndependentSlotsWithFlagValue(&cachePool->refinementCache, oldGlobalFlag);  // refinement cache never matches global time anyway
-        bumpValidFlagsForLocationIndependentSlotsWithFlagValue(&cachePool->midnightCache, oldGlobalFlag);
-        bumpValidFlagsForLocationIndependentSlotsWithFlagValue(&cachePool->year2000Cache, oldGlobalFlag);
-    }
+    cachePool->runningBackward = runningBackward;
+    cachePool->observerLatitude = observerLatitude;
+    cachePool->observerLongitude = observerLongitude;
+    cachePool->tzOffsetSeconds = tzOffsetSeconds;
 }
 
 void reinitializeECAstroCache(ECAstroCache *valueCache) {
@@ -73,6 +227,223 @@ void reinitializeECAstroCache(ECAstroCache *valueCache) {
     }
 }
 
+static void invalidateECAstroCache(ECAstroCache *valueCache) {
+    if (valueCache->currentFlag == 0xffffffff) {  // this won't happen very often :-)
+	reinitializeECAstroCache(valueCache);
+    } else {
+	valueCache->currentFlag++;
+    }
+}
+
+static void recordObserverInCache(ECAstroCache     *valueCache,
+				  ECAstroCachePool *cachePool) {
+    valueCache->observerLatitude = cachePool->observerLatitude;
+    valueCache->observerLongitude = cachePool->observerLongitude;
+    valueCache->tzOffsetSeconds = cachePool->tzOffsetSeconds;
+    valueCache->runningBackward = cachePool->runningBackward;
+}
+
+static unsigned int changedObserverDependencies(ECAstroCache     *valueCache,
+						ECAstroCachePool *cachePool) {
+    unsigned int changed = 0;
+    if (valueCache->observerLatitude != cachePool->observerLatitude ||
+	valueCache->observerLongitude != cachePool->observerLongitude) {
+	changed |= ECSlotDependsOnLocation;
+    }
+    if (valueCache->tzOffsetSeconds != cachePool->tzOffsetSeconds) {
+	changed |= ECSlotDependsOnTZOffset;
+    }
+    if (valueCache->runningBackward != cachePool->runningBackward) {
+	changed |= ECSlotDependsOnDirection;
+    }
+    return changed;
+}
+
+// Invalidate only the slots depending on the given parameters or in the given slop groups (a mask of 1 << ECSlopGroup),
+// by carrying the other currently valid slots forward to the new flag value
+static void invalidateSlotsWithDependencies(ECAstroCache *valueCache,
+					    unsigned int dependencies,
+					    unsigned int slopGroupMask) {
+    unsigned int oldFlag = valueCache->currentFlag;
+    invalidateECAstroCache(valueCache);
+    if (valueCache->currentFlag == oldFlag + 1) {  // i.e., not reinitialized
+	unsigned int newFlag = valueCache->currentFlag;
+	for (int i = 0; i < numCacheSlots; i++) {
+	    if (valueCache->cacheSlotValidFlag[i] == oldFlag &&
+		!(cacheSlotDependencies[i] & dependencies) &&
+		!((1 << cacheSlotSlopGroups[i]) & slopGroupMask)) {
+		valueCache->cacheSlotValidFlag[i] = newFlag;
+	    }
+	}
+    }
+}
+
+static void setSlopGroupDates(ECAstroCache   *valueCache,
+			      unsigned int   slopGroupMask,
+			      ESTimeInterval dateInterval) {
+    for (int g = 0; g < ECNumSlopGroups; g++) {
+	if (slopGroupMask & (1 << g)) {
+	    valueCache->slopGroupDateInterval[g] = dateInterval;
+	}
+    }
+    if (slopGroupMask & (1 << ECSlopGroupDefault)) {
+	valueCache->dateInterval = dateInterval;
+    }
+}
+
+#define ALL_SLOP_GROUPS ((1 << ECNumSlopGroups) - 1)
+
+// Return a mask of the slop groups whose slots are too far from the given date to be used there
+static unsigned int staleSlopGroups(ECAstroCache   *valueCache,
+				    ESTimeInterval dateInterval,
+				    ESTimeInterval slop) {
+    unsigned int stale = 0;
+    for (int g = 0; g < ECNumSlopGroups; g++) {
+	ESTimeInterval groupDate = valueCache->slopGroupDateInterval[g];
+	if (isnan(groupDate) || fabs(dateInterval - groupDate) > effectiveSlopForSlopGroup(g, slop)) {
+	    stale |= (1 << g);
+	}
+    }
+    return stale;
+}
+
+// Invalidate what's needed for the cache to be used at the given date by the pool's observer; return true if anything survived
+static bool invalidateSlotsForChanges(ECAstroCache     *valueCache,
+				      ECAstroCachePool *cachePool,
+				      ESTimeInterval   dateInterval,
+				      ESTimeInterval   slop) {
+    unsigned int stale = staleSlopGroups(valueCache, dateInterval, slop);
+    if (stale == ALL_SLOP_GROUPS) {
+	return false;
+    }
+    unsigned int changed = changedObserverDependencies(valueCache, cachePool);
+    if (changed || stale) {
+	invalidateSlotsWithDependencies(valueCache, changed, stale);
+	recordObserverInCache(valueCache, cachePool);
+	setSlopGroupDates(valueCache, stale, dateInterval);
+    }
+    return true;
+}
+
+// Copy the valid slots of non-default slop groups from a cache (for the same observer) whose group dates are close enough
+// to dateInterval; used when a final cache is recycled, so slowly varying values survive jumps to a new instant
+static void inheritSlopGroupsFromCache(ECAstroCache   *valueCache,
+				       ECAstroCache   *fromCache,
+				       ESTimeInterval dateInterval) {
+    // Each group by its own configured slop (staleSlopGroups would apply a zero Default slop to every group)
+    unsigned int fresh = 0;
+    for (int g = 0; g < ECNumSlopGroups; g++) {
+	ESTimeInterval groupDate = fromCache->slopGroupDateInterval[g];
+	if (g != ECSlopGroupDefault && !isnan(groupDate) && fabs(dateInterval - groupDate) <= slopGroupSlops[g]) {
+	    fresh |= (1 << g);
+	}
+    }
+    if (!fresh) {
+	return;
+    }
+    for (int i = 0; i < numCacheSlots; i++) {
+	if (((1 << cacheSlotSlopGroups[i]) & fresh) &&
+	    fromCache->cacheSlotValidFlag[i] == fromCache->currentFlag) {
+	    valueCache->cacheSlotValidFlag[i] = valueCache->currentFlag;
+	    valueCache->cacheSlots[i] = fromCache->cacheSlots[i];
+	}
+    }
+    for (int g = 0; g < ECNumSlopGroups; g++) {
+	if (fresh & (1 << g)) {
+	    valueCache->slopGroupDateInterval[g] = fromCache->slopGroupDateInterval[g];
+	}
+    }
+}
+
+// Start a recycled final cache from an entry at the same date but for another observer:  copy the entry's valid slots
+// which don't depend on any of the observer parameters that differ (the location-independent ones, when the location
+// differs), along with its dates, so the push which follows invalidates whatever groups are too old for dateInterval
+static void copySlotsFromOtherObserverCache(ECAstroCache     *valueCache,
+					    ECAstroCache     *fromCache,
+					    ECAstroCachePool *cachePool) {
+    unsigned int changed = changedObserverDependencies(fromCache, cachePool);
+    for (int i = 0; i < numCacheSlots; i++) {
+	if (fromCache->cacheSlotValidFlag[i] == fromCache->currentFlag &&
+	    !(cacheSlotDependencies[i] & changed)) {
+	    valueCache->cacheSlotValidFlag[i] = valueCache->currentFlag;
+	    valueCache->cacheSlots[i] = fromCache->cacheSlots[i];
+	}
+    }
+    for (int g = 0; g < ECNumSlopGroups; g++) {
+	valueCache->slopGroupDateInterval[g] = fromCache->slopGroupDateInterval[g];
+    }
+    valueCache->dateInterval = fromCache->dateInterval;
+}
+
+// Find the final cache for this date and observer.  Each entry is keyed by its date (matched within the default slop, as
+// pushECAstroCacheWithSlopInPool does) and the observer parameters it was filled for:
+//   1) An entry with the same key is used as is
+//   2) Otherwise the least-recently-used entry is recycled.  It starts with what can be shared from a live entry for the
+//      same date and another observer (as with a world clock showing "now" in several cities), or failing that with the
+//      slowly varying values of the most recently used entry for this observer.
+// An entry for another observer is never changed to serve this one, so switching back to it finds it intact.
+static ECAstroCache *selectFinalCacheInPool(ECAstroCachePool *cachePool,
+					    ESTimeInterval   dateInterval) {
+    int matchIndex = -1;
+    int sameDateIndex = -1;
+    int lruIndex = 0;
+    for (int i = 0; i < ECNumFinalCaches; i++) {
+	ECAstroCache *cache = &cachePool->finalCaches[i];
+	if (cache->globalValidFlag == cachePool->currentGlobalCacheFlag &&
+	    cache->currentFlag != 0 &&
+	    fabs(dateInterval - cache->dateInterval) <= slopGroupSlops[ECSlopGroupDefault]) {
+	    if (!changedObserverDependencies(cache, cachePool)) {
+		matchIndex = i;
+		break;
+	    } else if (sameDateIndex < 0 ||
+		       cachePool->finalCacheLastUsed[i] > cachePool->finalCacheLastUsed[sameDateIndex]) {
+		sameDateIndex = i;
+	    }
+	}
+	if (cachePool->finalCacheLastUsed[i] < cachePool->finalCacheLastUsed[lruIndex]) {
+	    lruIndex = i;
+	}
+    }
+    int index;
+    if (matchIndex >= 0) {
+	index = matchIndex;
+    } else if (sameDateIndex == lruIndex) {
+	// The only other entry for this date is the one being recycled anyway, so keep what it can share in place; the
+	// push invalidates the slots depending on what differs
+	index = lruIndex;
+    } else {
+	index = lruIndex;
+	ECAstroCache *cache = &cachePool->finalCaches[index];
+	if (cache->currentFlag == 0) {
+	    cache->currentFlag = 1;
+	}
+	invalidateECAstroCache(cache);
+	cache->globalValidFlag = cachePool->currentGlobalCacheFlag;
+	setSlopGroupDates(cache, ALL_SLOP_GROUPS, dateInterval);
+	if (sameDateIndex >= 0) {
+	    copySlotsFromOtherObserverCache(cache, &cachePool->finalCaches[sameDateIndex], cachePool);
+	    recordObserverInCache(cache, cachePool);
+	} else {
+	    recordObserverInCache(cache, cachePool);
+	    // Pick up slowly varying values from the most recently used entry, if it's for the same observer
+	    int mruIndex = -1;
+	    for (int i = 0; i < ECNumFinalCaches; i++) {
+		if (i != index &&
+		    cachePool->finalCaches[i].globalValidFlag == cachePool->currentGlobalCacheFlag &&
+		    cachePool->finalCaches[i].currentFlag != 0 &&
+		    (mruIndex < 0 || cachePool->finalCacheLastUsed[i] > cachePool->finalCacheLastUsed[mruIndex])) {
+		    mruIndex = i;
+		}
+	    }
+	    if (mruIndex >= 0 && !changedObserverDependencies(&cachePool->finalCaches[mruIndex], cachePool)) {
+		inheritSlopGroupsFromCache(cache, &cachePool->finalCaches[mruIndex], dateInterval);
+	    }
+	}
+    }
+    cachePool->finalCacheLastUsed[index] = ++cachePool->finalCacheUseStamp;
+    return &cachePool->finalCaches[index];
+}
+
 // Set the given value cache active, and return the previously active cache
 // so it can be popped to later.  If dateInterval isn't sufficiently
 // close to cached value, invalidate the cache.
@@ -101,24 +472,30 @@ ECAstroCache *pushECAstroCacheWithSlopInPool(ECAstroCachePool *cachePool,
 	}
     } else if (isnan(valueCache->dateInterval)) {
 	goto invalid;
-    } else if (fabs(dateInterval - valueCache->dateInterval) > slop) {
+    } else if (!invalidateSlotsForChanges(valueCache, cachePool, dateInterval, slop)) {
 	goto invalid;
     }
     return oldCache;
  invalid:
-    if (valueCache->currentFlag == 0xffffffff) {  // this won't happen very often :-)
-	reinitializeECAstroCache(valueCache);
-    } else {
-	valueCache->currentFlag++;
-    }
-    valueCache->dateInterval = dateInterval;
+    invalidateECAstroCache(valueCache);
+    setSlopGroupDates(valueCache, ALL_SLOP_GROUPS, dateInterval);
+    recordObserverInCache(valueCache, cachePool);
     return oldCache;
 }
 
 ECAstroCache *pushECAstroCacheInPool(ECAstroCachePool *cachePool,
 				     ECAstroCache     *valueCache,
 				     ESTimeInterval   dateInterval) {
-    return pushECAstroCacheWithSlopInPool(cachePool, valueCache, dateInterval, ASTRO_SLOP_RAW);
+    return pushECAstroCacheWithSlopInPool(cachePool, valueCache, dateInterval, slopGroupSlops[ECSlopGroupDefault]);
+}
+
+ECAstroCache *pushFinalCacheInPool(ECAstroCachePool *cachePool,
+				   ESTimeInterval   dateInterval) {
+    ESAssert(!isnan(dateInterval));
+    cachePool->finalCache = selectFinalCacheInPool(cachePool, dateInterval);
+    ECAstroCache *oldCache = pushECAstroCacheInPool(cachePool, cachePool->finalCache, dateInterval);
+    importSharedLocationIndependentSlots(cachePool->finalCache, cachePool->runningBackward);
+    return oldCache;
 }
 
 // The given cache is presumed to still represent the correct date interval.
@@ -139,6 +516,8 @@ void printCache(ECAstroCache     *valueCache,
 void initializeAstroCache() {
     astroCachePools[0].currentGlobalCacheFlag = 1;
     astroCachePools[1].currentGlobalCacheFlag = 1;
+    setupCacheSlotDependencies();
+    setupCacheSlotSlopGroups();
 }
 
 void assertCacheValidForTDTCenturies(ECAstroCache *cache,
@@ -167,21 +546,124 @@ void initializeCachePool(ECAstroCachePool *pool,
     setupGlobalCacheFlag(pool, observerLatitude, observerLongitude, runningBackward, tzOffsetSeconds);
     if (pool->inActionButton) {
 	ESAssert(pool->currentCache);
-	pushECAstroCacheInPool(pool, &pool->finalCache, dateInterval);
+	pushFinalCacheInPool(pool, dateInterval);
     } else {
 	ESAssert(!pool->currentCache);
-	pushECAstroCacheInPool(pool, &pool->finalCache, dateInterval);
+	pushFinalCacheInPool(pool, dateInterval);
     }
 }
 
 void releaseCachePoolForThisThread(ECAstroCachePool *cachePool) {
     ESAssert(cachePool == &astroCachePools[ESThread::inMainThread() ? 0 : 1]);
     ESAssert(cachePool->currentCache);
+    if (cachePool->finalCache) {
+	publishSharedLocationIndependentSlots(cachePool->finalCache, cachePool->runningBackward);
+    }
     popECAstroCacheToInPool(cachePool, NULL);
 }
 
 void clearAllCaches() {
     astroCachePools[0].currentGlobalCacheFlag++;
     astroCachePools[1].currentGlobalCacheFlag++;
+    sharedCacheGeneration++;
+}
+
+// A few slots before firstLocationDependentSlotIndex depend on the time zone, so they can't be shared
+static bool slotIsShareable(int slotIndex) {
+    return !(cacheSlotDependencies[slotIndex] & (ECSlotDependsOnLocation | ECSlotDependsOnTZOffset));
+}
+
+void importSharedLocationIndependentSlots(ECAstroCache *valueCache,
+					  bool         runningBackward) {
+    ESAssert(valueCache);
+    if (isnan(valueCache->dateInterval)) {
+	return;
+    }
+    long long bucket;
+    if (!sharedCacheBucketForDate(valueCache->dateInterval, &bucket)) {
+	return;
+    }
+    ECSharedAstroCacheEntry *entry = sharedCacheEntryForBucket(bucket);
+    unsigned int sequence = entry->sequence.load(std::memory_order_acquire);
+    if (sequence & 1) {
+	return;  // being written; don't wait
+    }
+    if (entry->generation.load(std::memory_order_relaxed) != sharedCacheGeneration.load(std::memory_order_relaxed) ||
+	entry->bucket.load(std::memory_order_relaxed) != bucket ||
+	entry->numValidSlots.load(std::memory_order_relaxed) == 0 ||
+	fabs(entry->dateInterval.load(std::memory_order_relaxed) - valueCache->dateInterval) > slopForSlopGroup(ECSlopGroupDefault)) {
+	return;
+    }
+    bool sameDirection = (entry->runningBackward.load(std::memory_order_relaxed) == runningBackward);
+    bool slotValid[firstLocationDependentSlotIndex];
+    double slots[firstLocationDependentSlotIndex];
+    for (int i = 0; i < firstLocationDependentSlotIndex; i++) {
+	slotValid[i] = entry->slotValid[i].load(std::memory_order_relaxed);
+	slots[i] = entry->slots[i].load(std::memory_order_relaxed);
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (entry->sequence.load(std::memory_order_relaxed) != sequence) {
+	return;  // torn read
+    }
+    unsigned int currentFlag = valueCache->currentFlag;
+    for (int i = 0; i < firstLocationDependentSlotIndex; i++) {
+	if (slotValid[i] &&
+	    valueCache->cacheSlotValidFlag[i] != currentFlag &&
+	    (sameDirection || !(cacheSlotDependencies[i] & ECSlotDependsOnDirection))) {
+	    valueCache->cacheSlotValidFlag[i] = currentFlag;
+	    valueCache->cacheSlots[i] = slots[i];
+	}
+    }
+}
+
+void publishSharedLocationIndependentSlots(ECAstroCache *valueCache,
+					   bool         runningBackward) {
+    ESAssert(valueCache);
+    if (isnan(valueCache->dateInterval)) {
+	return;
+    }
+    unsigned int currentFlag = valueCache->currentFlag;
+    int numValidSlots = 0;
+    for (int i = 0; i < firstLocationDependentSlotIndex; i++) {
+	if (valueCache->cacheSlotValidFlag[i] == currentFlag && slotIsShareable(i)) {
+	    numValidSlots++;
+	}
+    }
+    if (numValidSlots == 0) {
+	return;
+    }
+    long long bucket;
+    if (!sharedCacheBucketForDate(valueCache->dateInterval, &bucket)) {
+	return;
+    }
+    ECSharedAstroCacheEntry *entry = sharedCacheEntryForBucket(bucket);
+    unsigned int generation = sharedCacheGeneration.load(std::memory_order_relaxed);
+    unsigned int sequence = entry->sequence.load(std::memory_order_relaxed);
+    if (sequence & 1) {
+	return;  // someone else is writing it
+    }
+    // Don't bother rewriting an entry for this same instant which already knows at least as much as we do
+    // (A racy peek, since we don't hold the entry; a stale answer just means an unneeded or skipped rewrite)
+    if (entry->generation.load(std::memory_order_relaxed) == generation &&
+	entry->bucket.load(std::memory_order_relaxed) == bucket &&
+	entry->runningBackward.load(std::memory_order_relaxed) == runningBackward &&
+	entry->dateInterval.load(std::memory_order_relaxed) == valueCache->dateInterval &&
+	entry->numValidSlots.load(std::memory_order_relaxed) >= numValidSlots) {
+	return;
+    }
+    if (!entry->sequence.compare_exchange_strong(sequence, sequence + 1, std::memory_order_relaxed)) {
+	return;
+    }
+    std::atomic_thread_fence(std::memory_order_release);  // readers seeing any payload store below also see the odd sequence
+    entry->generation.store(generation, std::memory_order_relaxed);
+    entry->bucket.store(bucket, std::memory_order_relaxed);
+    entry->dateInterval.store(valueCache->dateInterval, std::memory_order_relaxed);
+    entry->runningBackward.store(runningBackward, std::memory_order_relaxed);
+    entry->numValidSlots.store(numValidSlots, std::memory_order_relaxed);
+    for (int i = 0; i < firstLocationDependentSlotIndex; i++) {
+	entry->slotValid[i].store(valueCache->cacheSlotValidFlag[i] == currentFlag && slotIsShareable(i), std::memory_order_relaxed);
+	entry->slots[i].store(valueCache->cacheSlots[i], std::memory_order_relaxed);
+    }
+    entry->sequence.store(sequence + 2, std::memory_order_release);
 }
 
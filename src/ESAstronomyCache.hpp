@@ -63,6 +63,15 @@ typedef enum _CacheSlotIndex {
     moonAscendingNodeRAJ2000SlotIndex,
     moonAscendingNodeDeclJ2000SlotIndex,
     precessionSlotIndex,
+    precessionMatrixSlotIndex,  // 3x3 row-major, J2000 to mean of date
+    precessionMatrixSlotIndex1,
+    precessionMatrixSlotIndex2,
+    precessionMatrixSlotIndex3,
+    precessionMatrixSlotIndex4,
+    precessionMatrixSlotIndex5,
+    precessionMatrixSlotIndex6,
+    precessionMatrixSlotIndex7,
+    precessionMatrixSlotIndex8,
     calendarErrorSlotIndex,
     realMoonAgeAngleSlotIndex,
     tdtCenturiesSlotIndex,
@@ -98,6 +107,10 @@ typedef enum _CacheSlotIndex {
     WBSunRadiusSlotIndex,
     WBNutationSlotIndex,
     WBObliquitySlotIndex,
+    WBMercuryLongitudeAberrationSlotIndex,  // Heliocentric long/lat/radius for the inner planets go in planetHeliocentric*SlotIndex
+    WBVenusLongitudeAberrationSlotIndex,
+    WBMarsLongitudeAberrationSlotIndex,
+    WBMercuryLatitudeAberrationSlotIndex,   // Venus and Mars have no latitude aberration term
     planetHeliocentricLongitudeSlotIndex,
     planetHeliocentricLongitudeSlotIndex1,
     planetHeliocentricLongitudeSlotIndex2,
@@ -479,30 +492,70 @@ typedef enum _CacheSlotIndex {
     numCacheSlots
 } CacheSlotIndex;
 
+// What the value in each slot depends on.  When a cache is pushed for a pool whose observer parameters differ from
+// those the cache was filled with, only the slots depending on the changed parameters are invalidated.  A change of date
+// beyond the slop still invalidates everything.  The table itself is in ESAstronomyCache.cpp (setupCacheSlotDependencies);
+// please keep it up to date when adding slots.
+typedef enum _ECCacheSlotDependency {
+    ECSlotDependsOnTime      = 0x01,
+    ECSlotDependsOnLocation  = 0x02,  // observer latitude and longitude
+    ECSlotDependsOnTZOffset  = 0x04,  // e.g., "for day" values and anything using local midnight
+    ECSlotDependsOnDirection = 0x08,  // next/prev values which flip when the watch runs backward
+    ECSlotDependsOnPrecision = 0x10   // ECWBPrecision; each precision has its own slot so this never causes invalidation
+} ECCacheSlotDependency;
+
+// Slots are also grouped by how fast their values change, and each group has its own tolerance ("slop") for how far the
+// date can move before the slot must be recalculated.  The default group uses the slop passed to pushECAstroCacheWithSlopInPool
+// (normally ASTRO_SLOP_RAW); the other groups use the tolerance set with setSlopForSlopGroup (but a push with zero slop always
+// demands exact values).  The group assignments are in ESAstronomyCache.cpp (setupCacheSlotSlopGroups).
+typedef enum _ECSlopGroup {
+    ECSlopGroupDefault,          // everything not listed below
+    ECSlopGroupAltAz,            // topocentric altitude/azimuth, which move with the Earth's rotation (15 arcseconds per second)
+    ECSlopGroupSlowlyVarying,    // precession, calendar error: good for an hour or more
+    ECNumSlopGroups
+} ECSlopGroup;
+
 typedef struct _ECAstroCache {
-    ESTimeInterval dateInterval;
+    ESTimeInterval dateInterval;  // Same as slopGroupDateInterval[ECSlopGroupDefault]
+    ESTimeInterval slopGroupDateInterval[ECNumSlopGroups];  // The date at which each group's slots were last invalidated
     ESTimeInterval astroSlop;
     unsigned int currentFlag;  // if validFlag[i] == currentFlag it means the cache slot is valid
     unsigned int globalValidFlag;   // to test against currentGlobalCacheFlag in a similar way;
     int inUseCount;
+    double       observerLatitude;   // The observer parameters the valid slots were calculated for
+    double       observerLongitude;
+    int          tzOffsetSeconds;
+    bool         runningBackward;
     unsigned int cacheSlotValidFlag[numCacheSlots];
     double cacheSlots[numCacheSlots];
 } ECAstroCache;
 
+// The "final" cache (the one representing the watch's current time and location) is really a small
+// set of caches, so that alternating between a handful of instants (e.g., a world-clock face showing
+// "now" in several cities, or "now" and "tomorrow") reuses prior work rather than invalidating a
+// single cache on every switch.  Each entry is keyed by its dateInterval (matched within the slop just as
+// pushECAstroCacheWithSlopInPool does) and the observer parameters it was filled for.  A miss recycles the
+// least-recently-used entry, copying into it the location-independent slots of any entry for the same
+// date; the other cities' entries are left alone, so cycling through them finds each one still filled.
+#define ECNumFinalCaches 4
+
 typedef struct _ECAstroCachePool {
     double       observerLatitude;
     double       observerLongitude;
     bool         runningBackward;
     int          tzOffsetSeconds;
     bool         inActionButton;
-    unsigned int currentGlobalCacheFlag;
-    ECAstroCache finalCache;
+    unsigned int currentGlobalCacheFlag;  // bumped only by clearAllCaches; observer changes are handled per slot
+    unsigned int finalCacheUseStamp;
+    ECAstroCache finalCaches[ECNumFinalCaches];
+    unsigned int finalCacheLastUsed[ECNumFinalCaches];  // for LRU replacement
+    ECAstroCache *finalCache;  // the entry of finalCaches most recently selected by pushFinalCacheInPool
     ECAstroCache tempCache;
     ECAstroCache refinementCache;
     ECAstroCache midnightCache;
     ECAstroCache year2000Cache;
     ECAstroCache *currentCache;
-} ECAstroCachePool;  // about 43k bytes used here in static storage
+} ECAstroCachePool;  // about 60k bytes used here in static storage
 
 #define ASTRO_SLOP_RAW (2.0)  // number of seconds of slop in astro functions -- if the date has not changed by this much we do not recalculate
 #define ASTRO_SLOP (_currentCache ? _currentCache->astroSlop : ASTRO_SLOP_RAW)
@@ -532,6 +585,12 @@ extern ECAstroCache *pushECAstroCacheWithSlopInPool(ECAstroCachePool *cachePool,
 						    ESTimeInterval   dateInterval,
 						    ESTimeInterval   slop);
 
+// Select the entry in the pool's final-cache ring which matches the given date interval and the pool's
+// current observer parameters (recycling the least-recently-used entry if none does), make it the pool's
+// finalCache, and push it as with pushECAstroCacheInPool.
+extern ECAstroCache *pushFinalCacheInPool(ECAstroCachePool *cachePool,
+					  ESTimeInterval   dateInterval);
+
 // The given cache is presumed to still represent the correct date interval, so no checking is done.
 extern void popECAstroCacheToInPool(ECAstroCachePool *cachePool,
 				    ECAstroCache     *valueCache);
@@ -548,4 +607,31 @@ extern void assertCacheValidForTDTHundredCenturies(ECAstroCache *cache,
 
 extern void clearAllCaches();
 
+// Return the ECCacheSlotDependency bits for the given slot
+extern unsigned int dependenciesForCacheSlot(int slotIndex);
+
+// Return the ECSlopGroup for the given slot
+extern ECSlopGroup slopGroupForCacheSlot(int slotIndex);
+
+// Tolerance, in seconds, for the given slot group.  Setting the default group's slop changes the slop used by pushECAstroCacheInPool.
+extern ESTimeInterval slopForSlopGroup(ECSlopGroup slopGroup);
+extern void setSlopForSlopGroup(ECSlopGroup    slopGroup,
+				ESTimeInterval slop);
+
+// Set the group's slop from the desired accuracy, using the fastest angular rate of any quantity in the group
+extern void setAccuracyTargetForSlopGroup(ECSlopGroup slopGroup,
+					  double      arcseconds);
+
+// The location-independent slots (those prior to firstLocationDependentSlotIndex) are the same for every observer
+// at a given instant, so they are also kept in a process-wide table shared by all threads, indexed by time bucket.
+// Readers never block; writers which find an entry busy simply skip publishing.
+
+// Fill in any invalid location-independent slots in valueCache from the shared table, if it has an entry for valueCache's date.
+extern void importSharedLocationIndependentSlots(ECAstroCache *valueCache,
+						 bool         runningBackward);
+
+// Copy the valid location-independent slots in valueCache into the shared table for other threads to use.
+extern void publishSharedLocationIndependentSlots(ECAstroCache *valueCache,
+						  bool         runningBackward);
+
 #endif // _ECASTRONOMY_CACHE_
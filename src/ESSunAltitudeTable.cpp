@@ -12,23 +12,215 @@
 #include "ESTrace.hpp"
 #include "ESFile.hpp"
 
-#define NUM_PARAMETRIC_POINTS 1000001  // Best if this is a multiple of 2 plus 1 -- that makes zero come out exact
-
-#if 0  // This would work except that the _SLOTS macros are arithmetic expressions
-#define ES_TABLE_FILE_FMT(SS,L,ALT) "SunAltitudeData-ss" #SS "-lat" #L "-alt" #ALT ".dat"
-#define ES_TABLE_FILE_X(SS,L,ALT) ES_TABLE_FILE_FMT(SS,L,ALT)
-#define ES_TABLE_FILE   ES_TABLE_FILE_X(ES_SUBSOLAR_SLOTS,ES_LATITUDE_SLOTS,ES_ALTITUDE_SLOTS)
-#else
-#define SETUP_TABLE_FILE_NAME \
-    char ES_TABLE_FILE[66];   \
-    snprintf(ES_TABLE_FILE, sizeof(ES_TABLE_FILE), "SunAltitudeData-ss%d-lat%d-alt%d-%d.dat", ES_SUBSOLAR_SLOTS, ES_LATITUDE_SLOTS, ES_ALTITUDE_SLOTS, -ES_ALT_MIN_DEGREES); \
-    ESAssert(strlen(ES_TABLE_FILE) < sizeof(ES_TABLE_FILE) - 2);
-#endif
+#include <stdlib.h>  // For posix_memalign
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <thread>
+#include <vector>
+
+#define ES_TABLE_ALIGNMENT 64  // Cache line; also enough for any vector unit we load rows into
+#define ES_TABLE_FILE_NAME_SIZE 80
+#define ES_TABLE_PATH_SIZE 1024
+#define ES_TABLE_HEADER_SIZE ((sizeof(ESSunAltitudeTableFileHeader) + ES_TABLE_ALIGNMENT - 1) & ~(size_t)(ES_TABLE_ALIGNMENT - 1))
+
+static_assert(sizeof(ESSunAltitudeTableFileHeader) == 64, "table file header layout must not depend on the compiler");
+
+static uint32_t swap32(uint32_t x) {
+    return (x >> 24) | ((x >> 8) & 0xff00) | ((x << 8) & 0xff0000) | (x << 24);
+}
+
+static void swap32Array(void   *array,
+                        size_t count) {
+    uint32_t *ptr = (uint32_t *)array;
+    uint32_t *stopPtr = ptr + count;
+    while (ptr < stopPtr) {
+        *ptr = swap32(*ptr);
+        ptr++;
+    }
+}
+
+// Puts a header written with the other byte order into ours.  The data is left alone.
+static void swapHeader(ESSunAltitudeTableFileHeader *header) {
+    swap32Array(&header->byteOrderMark, (&header->checksum + 1) - &header->byteOrderMark);
+    header->dataSize = ((uint64_t)swap32((uint32_t)header->dataSize) << 32) | swap32((uint32_t)(header->dataSize >> 32));
+}
+
+/*static*/ void
+ESSunAltitudeTable::getFileName(const ESSunAltitudeTableDimensions &dimensions,
+                                char                               *fileName,
+                                size_t                             fileNameSize) {
+    snprintf(fileName, fileNameSize, "SunAltitudeData-ss%d-lat%d-alt%d-%d.dat",
+             dimensions.subsolarSteps + 1, dimensions.latitudeSteps + 1, dimensions.altitudeSteps + 1, -dimensions.altitudeMinDegrees);
+    ESAssert(strlen(fileName) < fileNameSize - 2);
+}
+
+/*static*/ size_t
+ESSunAltitudeTable::dataSizeForDimensions(const ESSunAltitudeTableDimensions &dimensions) {
+    return (size_t)(dimensions.subsolarSteps + 1) * (dimensions.latitudeSteps + 1) * (dimensions.altitudeSteps + 1) * sizeof(float);
+}
+
+// Adler-32, as in zlib
+/*static*/ uint32_t
+ESSunAltitudeTable::checksumForData(const void *data,
+                                    size_t     dataSize) {
+    const uint32_t modulus = 65521;
+    const size_t maxRunBeforeModulus = 5552;  // Largest n for which the sums can't overflow 32 bits
+    const unsigned char *ptr = (const unsigned char *)data;
+    uint32_t a = 1;
+    uint32_t b = 0;
+    while (dataSize > 0) {
+        size_t run = dataSize < maxRunBeforeModulus ? dataSize : maxRunBeforeModulus;
+        dataSize -= run;
+        const unsigned char *stopPtr = ptr + run;
+        while (ptr < stopPtr) {
+            a += *ptr++;
+            b += a;
+        }
+        a %= modulus;
+        b %= modulus;
+    }
+    return (b << 16) | a;
+}
+
+// Returns aligned storage for a table of the given dimensions, with the header filled in except for the checksum
+/*static*/ void *
+ESSunAltitudeTable::allocateStorage(const ESSunAltitudeTableDimensions &dimensions) {
+    size_t dataSize = dataSizeForDimensions(dimensions);
+    void *storage;
+    if (posix_memalign(&storage, ES_TABLE_ALIGNMENT, ES_TABLE_HEADER_SIZE + dataSize) != 0) {
+        ESErrorReporter::logError("ESSunAltitudeTable", "Couldn't allocate %lu bytes for table\n", (unsigned long)(ES_TABLE_HEADER_SIZE + dataSize));
+        return NULL;
+    }
+    ESSunAltitudeTableFileHeader *header = (ESSunAltitudeTableFileHeader *)storage;
+    memset(header, 0, ES_TABLE_HEADER_SIZE);
+    memcpy(header->magic, ES_SUN_ALTITUDE_TABLE_FILE_MAGIC, sizeof(header->magic));
+    header->byteOrderMark = ES_SUN_ALTITUDE_TABLE_BYTE_ORDER_MARK;
+    header->version = ES_SUN_ALTITUDE_TABLE_FILE_VERSION;
+    header->headerSize = ES_TABLE_HEADER_SIZE;
+    header->subsolarSteps = dimensions.subsolarSteps;
+    header->latitudeSteps = dimensions.latitudeSteps;
+    header->altitudeSteps = dimensions.altitudeSteps;
+    header->altitudeMinDegrees = dimensions.altitudeMinDegrees;
+    header->dataSize = dataSize;
+    return storage;
+}
+
+// Checks a header in our byte order against the file it came from and the dimensions we asked for
+/*static*/ bool
+ESSunAltitudeTable::validateHeader(const ESSunAltitudeTableFileHeader *header,
+                                   size_t                             fileSize,
+                                   const ESSunAltitudeTableDimensions &dimensions,
+                                   bool                               verifyChecksum,
+                                   const char                         *fileName) {
+    if (fileSize < sizeof(*header) || memcmp(header->magic, ES_SUN_ALTITUDE_TABLE_FILE_MAGIC, sizeof(header->magic)) != 0) {
+        ESErrorReporter::logError("ESSunAltitudeTable", "Table file %s has no header\n", fileName);
+        return false;
+    }
+    if (header->byteOrderMark != ES_SUN_ALTITUDE_TABLE_BYTE_ORDER_MARK) {
+        ESErrorReporter::logError("ESSunAltitudeTable", "Table file %s has byte order mark 0x%08x, expected 0x%08x\n",
+                                  fileName, header->byteOrderMark, ES_SUN_ALTITUDE_TABLE_BYTE_ORDER_MARK);
+        return false;
+    }
+    if (header->version != ES_SUN_ALTITUDE_TABLE_FILE_VERSION) {
+        ESErrorReporter::logError("ESSunAltitudeTable", "Table file %s is version %u, expected %u\n",
+                                  fileName, header->version, ES_SUN_ALTITUDE_TABLE_FILE_VERSION);
+        return false;
+    }
+    ESSunAltitudeTableDimensions fileDimensions = { header->subsolarSteps, header->latitudeSteps, header->altitudeSteps, header->altitudeMinDegrees };
+    if (!(fileDimensions == dimensions)) {
+        ESErrorReporter::logError("ESSunAltitudeTable", "Table file %s has dimensions ss%d-lat%d-alt%d-%d, not the ones in its name\n",
+                                  fileName, fileDimensions.subsolarSteps + 1, fileDimensions.latitudeSteps + 1, fileDimensions.altitudeSteps + 1,
+                                  -fileDimensions.altitudeMinDegrees);
+        return false;
+    }
+    if (header->headerSize < sizeof(*header) || header->headerSize % ES_TABLE_ALIGNMENT != 0 ||
+        header->dataSize != dataSizeForDimensions(dimensions) ||
+        fileSize < header->headerSize + header->dataSize) {
+        ESErrorReporter::logError("ESSunAltitudeTable", "Table file %s is %lu bytes, with header size %u and data size %llu\n",
+                                  fileName, (unsigned long)fileSize, header->headerSize, (unsigned long long)header->dataSize);
+        return false;
+    }
+    if (verifyChecksum) {
+        uint32_t checksum = checksumForData((const char *)header + header->headerSize, header->dataSize);
+        if (checksum != header->checksum) {
+            ESErrorReporter::logError("ESSunAltitudeTable", "Table file %s has checksum 0x%08x, expected 0x%08x\n",
+                                      fileName, checksum, header->checksum);
+            return false;
+        }
+    }
+    return true;
+}
+
+ESSunAltitudeTable::ESSunAltitudeTable(void   *storage,
+                                       size_t mappedSize)
+:   _storage(storage),
+    _mappedSize(mappedSize)
+{
+    const ESSunAltitudeTableFileHeader *header = (const ESSunAltitudeTableFileHeader *)storage;
+    _dimensions.subsolarSteps = header->subsolarSteps;
+    _dimensions.latitudeSteps = header->latitudeSteps;
+    _dimensions.altitudeSteps = header->altitudeSteps;
+    _dimensions.altitudeMinDegrees = header->altitudeMinDegrees;
+    _longitudes = (float *)((char *)storage + header->headerSize);
+    ESAssert(_dimensions.subsolarSteps > 0);
+    ESAssert(_dimensions.latitudeSteps > 0);
+    ESAssert(_dimensions.altitudeSteps > 0);
+    ESAssert(_dimensions.altitudeMinDegrees < 0);
+}
+
+ESSunAltitudeTable::~ESSunAltitudeTable() {
+    if (_mappedSize) {
+        munmap(_storage, _mappedSize);
+    } else {
+        free(_storage);
+    }
+}
+
+double
+ESSunAltitudeTable::subsolarLatitudeForIndex(int subsolarIndex) const {
+    return ES_SUBSOLAR_MIN + (subsolarIndex * ES_SUBSOLAR_RANGE / _dimensions.subsolarSteps);
+}
+
+double
+ESSunAltitudeTable::latitudeForIndex(int mapLatitudeIndex) const {
+    return -M_PI/2 + (mapLatitudeIndex * M_PI / _dimensions.latitudeSteps);
+}
+
+int
+ESSunAltitudeTable::indexForLatitude(double mapLatitude) const {
+    return (int)round((mapLatitude + M_PI/2)/M_PI * _dimensions.latitudeSteps);
+}
+
+double
+ESSunAltitudeTable::altitudeForIndex(int altitudeIndex) const {
+    double altitudeMin = _dimensions.altitudeMinDegrees * M_PI / 180;
+    return ES_ALT_MAX - (altitudeIndex * (ES_ALT_MAX - altitudeMin) / _dimensions.altitudeSteps);
+}
+
+// Splits a fractional slot index into the slot before it (so that there's always one after it) and the weight of the one after
+static void getInterpolatedIndex(double indexD,
+                                 int    steps,
+                                 int    *beforeIndex,
+                                 float  *afterWeight) {
+    ESAssert(indexD > -0.0001 && indexD < steps + 0.0001);
+    int index = (int)floor(indexD);
+    if (index < 0) {
+        index = 0;
+    } else if (index > steps - 1) {
+        index = steps - 1;
+    }
+    *beforeIndex = index;
+    *afterWeight = (float)(indexD - index);
+}
 
 // Returns true iff sslat < 0 and latitude should be flipped
 static bool getInterpolatedSSLatIndex(double sslat,
+                                      int    subsolarSteps,
                                       int    *beforeIndex,
-                                      int    *afterIndex) {
+                                      float  *afterWeight) {
     bool flipLatitude;
     if (sslat < 0) {
         flipLatitude = true;
@@ -36,312 +228,386 @@ static bool getInterpolatedSSLatIndex(double sslat,
     } else {
         flipLatitude = false;
     }
-    double ssLatIndexD = (sslat - ES_SUBSOLAR_MIN) * ES_SUBSOLAR_STEPS / ES_SUBSOLAR_RANGE;
-    *beforeIndex = floor(ssLatIndexD);
-    *afterIndex = ceil(ssLatIndexD);
-    ESAssert(*beforeIndex >= 0);
-    ESAssert(*afterIndex < ES_SUBSOLAR_SLOTS);
+    double ssLatIndexD = (sslat - ES_SUBSOLAR_MIN) * subsolarSteps / ES_SUBSOLAR_RANGE;
+    getInterpolatedIndex(ssLatIndexD, subsolarSteps, beforeIndex, afterWeight);
     return flipLatitude;
 }
 
-#if 0  // Unused
-static void getInterpolatedLatIndex(double lat,
-                                    int    *beforeIndex,
-                                    int    *afterIndex) {
-    double latIndexD = (lat - ES_LATITUDE_MIN) * ES_LATITUDE_STEPS / ES_LATITUDE_RANGE;
-    *beforeIndex = floor(latIndexD);
-    *afterIndex = ceil(latIndexD);
-    ESAssert(*beforeIndex >= 0);
-    ESAssert(*afterIndex < ES_LATITUDE_SLOTS);
-}
-#endif
-
 /*static*/ ESSunAltitudeTable *
-ESSunAltitudeTable::createFromFile() {
-    SETUP_TABLE_FILE_NAME
+ESSunAltitudeTable::createFromFile(const ESSunAltitudeTableDimensions &dimensions) {
+    char fileName[ES_TABLE_FILE_NAME_SIZE];
+    getFileName(dimensions, fileName, sizeof(fileName));
     size_t tableSize;
-    char *ptr = ESFile::getFileContentsInMallocdArray(ES_TABLE_FILE,
+    char *ptr = ESFile::getFileContentsInMallocdArray(fileName,
                                                       ESFilePathTypeRelativeToResourceDir,
                                                       false/*missingOK*/,
                                                       &tableSize);
-    return (ESSunAltitudeTable *)ptr;
+    if (!ptr) {
+        return NULL;
+    }
+    ESSunAltitudeTableFileHeader *header = (ESSunAltitudeTableFileHeader *)ptr;
+    size_t dataSize = dataSizeForDimensions(dimensions);
+    if (tableSize == dataSize &&
+        (tableSize < sizeof(*header) || memcmp(header->magic, ES_SUN_ALTITUDE_TABLE_FILE_MAGIC, sizeof(header->magic)) != 0)) {
+        // An old file with just the data; give it a header
+        void *storage = allocateStorage(dimensions);
+        if (storage) {
+            ESSunAltitudeTableFileHeader *newHeader = (ESSunAltitudeTableFileHeader *)storage;
+            memcpy((char *)storage + newHeader->headerSize, ptr, dataSize);
+            newHeader->checksum = checksumForData((char *)storage + newHeader->headerSize, dataSize);
+        }
+        free(ptr);
+        return storage ? new ESSunAltitudeTable(storage, 0) : NULL;
+    }
+    bool swapped = tableSize >= sizeof(*header) && header->byteOrderMark == swap32(ES_SUN_ALTITUDE_TABLE_BYTE_ORDER_MARK);
+    if (swapped) {
+        swapHeader(header);
+    }
+    if (!validateHeader(header, tableSize, dimensions, true/*verifyChecksum*/, fileName)) {
+        free(ptr);
+        return NULL;
+    }
+    if (swapped) {
+        // The checksum covers the bytes as written; redo it for the bytes as we now hold them
+        swap32Array(ptr + header->headerSize, header->dataSize / sizeof(float));
+        header->byteOrderMark = ES_SUN_ALTITUDE_TABLE_BYTE_ORDER_MARK;
+        header->checksum = checksumForData(ptr + header->headerSize, header->dataSize);
+    }
+    // malloc's alignment is less than ES_TABLE_ALIGNMENT but enough for floats and for 128-bit vector loads
+    return new ESSunAltitudeTable(ptr, 0);
 }
 
 /*static*/ ESSunAltitudeTable *
-ESSunAltitudeTable::createFromScratch() {
+ESSunAltitudeTable::createByMappingFile(const char                         *directoryPath,
+                                        const ESSunAltitudeTableDimensions &dimensions,
+                                        bool                               verifyChecksum) {
+    char fileName[ES_TABLE_FILE_NAME_SIZE];
+    getFileName(dimensions, fileName, sizeof(fileName));
+    char path[ES_TABLE_PATH_SIZE];
+    if ((size_t)snprintf(path, sizeof(path), "%s/%s", directoryPath, fileName) >= sizeof(path)) {
+        ESErrorReporter::logError("ESSunAltitudeTable", "Table directory path too long: %s\n", directoryPath);
+        return NULL;
+    }
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        ESErrorReporter::logError("ESSunAltitudeTable", "Couldn't open table file %s: %s\n", path, strerror(errno));
+        return NULL;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(ESSunAltitudeTableFileHeader)) {
+        ESErrorReporter::logError("ESSunAltitudeTable", "Table file %s is missing its header\n", path);
+        close(fd);
+        return NULL;
+    }
+    size_t mappedSize = st.st_size;
+    void *base = mmap(NULL, mappedSize, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);  // The mapping keeps the file open
+    if (base == MAP_FAILED) {
+        ESErrorReporter::logError("ESSunAltitudeTable", "Couldn't map table file %s: %s\n", path, strerror(errno));
+        return NULL;
+    }
+    const ESSunAltitudeTableFileHeader *header = (const ESSunAltitudeTableFileHeader *)base;
+    if (header->byteOrderMark != ES_SUN_ALTITUDE_TABLE_BYTE_ORDER_MARK) {
+        // Read-only pages can't be swapped in place; createFromFile can read such a file
+        ESErrorReporter::logError("ESSunAltitudeTable", "Table file %s has byte order mark 0x%08x, which we can't map\n", path, header->byteOrderMark);
+        munmap(base, mappedSize);
+        return NULL;
+    }
+    if (!validateHeader(header, mappedSize, dimensions, verifyChecksum, path)) {
+        munmap(base, mappedSize);
+        return NULL;
+    }
+    return new ESSunAltitudeTable(base, mappedSize);
+}
+
+/*static*/ ESSunAltitudeTable *
+ESSunAltitudeTable::createFromScratch(const ESSunAltitudeTableDimensions &dimensions) {
 #ifdef ESTRACE
-    SETUP_TABLE_FILE_NAME
-    tracePrintf1("Table file is %s\n", ES_TABLE_FILE)
+    char fileName[ES_TABLE_FILE_NAME_SIZE];
+    getFileName(dimensions, fileName, sizeof(fileName));
+    tracePrintf1("Table file is %s\n", fileName)
 #endif
-    ESSunAltitudeTable *table = new ESSunAltitudeTable;
+    void *storage = allocateStorage(dimensions);
+    if (!storage) {
+        return NULL;
+    }
+    ESSunAltitudeTable *table = new ESSunAltitudeTable(storage, 0);
     table->fillInFromScratch();
     return table;
 }
 
-static double
-infinityForSSLatAlt(double subSolarLatitude,
-                    double latitude,
-                    double altitude) {
-    // Representation of longitude if the curve doesn't cross the given latitude:
-    // We want pi if the Sun is always above the given altitude, and zero if it's always below, because
-    //   the larger the longitude, the further we go (from longitude zero) before starting the night region (and pi is as far as we can go)
-    // But it's a bit tricky figuring that out:  It only happens near the poles (for negative altitudes relatively near zero,
-    //   which is what we're dealing with).  The Sun can be always up if either
-    //   - the pole is in summer or
-    //   - the pole is somewhat in winter but the altitude threshold is sufficiently negative that the Sun never gets down that far
-    //   The Sun can be always down if the pole is in winter and the altitude threshold is sufficiently close to zero that
-    //   the Sun never gets *up* that far.
-
-    //   At Jun solstice (sslat +23.4):
-    //   lat   alt         avg
-    //    90   23 ->  23    23
-    //    45  -22 ->  68    23
-    //    23  -43 ->  90    23
-    //    10  -57 ->  77    10
-    //     0  -67 ->  67     0
-    //   -10  -77 ->  57   -10
-    //   -23  -90 ->  43   -23
-    //   -30  -83 ->  37   -23
-    //   -45  -68 ->  22   -23
-    //   -80  -33 -> -13   -23
-    //   -90  -23 -> -23   -23
-
-    //  At sslat 10:
-    //    90   10 ->  10    10
-    //    45  
-    //    23  -57 ->  77    10
-    //    10  -70 ->  90    10
-    //     0  -80 ->  80     0
-    //   -10  -90 ->  70   -10
-    //   -23  -77 ->  57   -10
-    //   -30  -70 ->  50   -10  
-    //   -45  
-    //   -80  
-    //   -90  
-
-    //  At Equinox (sslat 0):
-    //    90    0 ->  0      0
-    //    45  -45 -> 45      0
-    //    23  -68 -> 68      0
-    //    10  -80 -> 80      0
-    //     0  -90 -> 90      0
-    //   -10  -80 -> 80      0
-    //   -23  -68 -> 68      0
-    //   -30  -60 -> 60      0
-    //   -45  -45 -> 45      0
-    //   -80  -10 -> 10      0
-    //   -90    0 ->  0      0
-
-    //  altMax =  90 - abs(lat - sslat);
-    //  altMin = -90 + abs(lat + sslat);
-
-    //  altAvg = (altMax+altMin)/2
-    //  altAvg = abs(lat + sslat) - abs(lat - sslat)
-
-    // double altMax =  M_PI/2 - fabs(latitude - subSolarLatitude);
-    // double altMin = -M_PI/2 + fabs(latitude + subSolarLatitude);
-    // double altAvg = (altMax + altMin) / 2.0;
-
-    // bool polarWinter = altitude > altMax;  // if the altitude is above the max for this latitude, the Sun never gets up this high and we're in Winter
-    // bool polarSummer = altitude < altMin;  // if the altitude is below the min for this latitude, the Sun never gets down this low and we're in Summer
-
-    double altMax =  M_PI/2 - fabs(latitude - subSolarLatitude);
-    double altMin = -M_PI/2 + fabs(latitude + subSolarLatitude);
-    // double altAvg = (fabs(latitude - subSolarLatitude) - fabs(latitude + subSolarLatitude)) / 2;
-    if (altitude > altMax - .0001) {
-        // The altitude is above the max for this latitude, the Sun never gets up this high and we're in winter
+/*static*/ double
+ESSunAltitudeTable::longitudeForAltitude(double subsolarLatitude,
+                                         double mapLatitude,
+                                         double sunAltitude) {
+    // The Sun is at altitude h from latitude B and hour angle H (which is the longitude measured from the subsolar point)
+    // when sin h = sin B sin sslat + cos B cos sslat cos H.  Where the Sun never gets up to h at this latitude, cos H comes out
+    // above 1 and we want zero:  the night region starts right at the subsolar longitude.  Where it never gets down to h,
+    // cos H is below -1 and we want pi, as far as we can go before starting the night region.  At the poles the denominator
+    // all but vanishes and the sign of the numerator alone picks between those two; a Sun that circles exactly at h (the pole
+    // at an equinox, for h = 0) gives pi/2, half way.
+    double numerator = sin(sunAltitude) - sin(mapLatitude)*sin(subsolarLatitude);
+    double denominator = cos(mapLatitude)*cos(subsolarLatitude);
+    if (numerator >= denominator) {
         return 0;
-    } else if (altitude < altMin + 0.0001) {
-        // if the altitude is below the min for this latitude, the Sun never gets down this low and we're in Summer
+    } else if (numerator <= -denominator) {
         return M_PI;
-    } else {
-        printf("altMax %.2f (now %.2f), fabs %.2f, lat %.2f, ssl %.2f\n",
-               altMax*180/M_PI, 
-               (M_PI - fabs(latitude - subSolarLatitude))*180/M_PI,
-               fabs(latitude - subSolarLatitude)*180/M_PI, latitude*180/M_PI, subSolarLatitude*180/M_PI);
-        ESAssert(false);
-        return 0;
     }
+    return acos(numerator / denominator);
 }
 
-
 void
 ESSunAltitudeTable::fillInFromScratch() {
-    traceEnter3("ESSunAltitudeTable::fillInFromScratch ss%d-lat%d-alt%d", ES_SUBSOLAR_SLOTS, ES_LATITUDE_SLOTS, ES_ALTITUDE_SLOTS);
-    tracePrintf1("table size is %ld", sizeof(*this));
-
-    for (int subsolarIndex = 0; subsolarIndex < ES_SUBSOLAR_SLOTS; subsolarIndex++) {
-        double subSolarLatitude = ES_INDEX_TO_SUBSOLAR(subsolarIndex);
-        traceEnter2("subSolar index %d (%.2f)", subsolarIndex, subSolarLatitude*180/M_PI);
-
-        ESSunAltitudeMapTable *altitudeMapTable = &_altitudeMapForSubSolarLatitude[subsolarIndex];
-
-        for (int altitudeIndex = 0; altitudeIndex < ES_ALTITUDE_SLOTS; altitudeIndex++) {
-            double sunAltitude = ES_INDEX_TO_ALT(altitudeIndex);
-
-            ESAssert(subSolarLatitude >= 0);  // If ssLat is < 0, flip the sign of the input latitude when looking up values
-            const double cossslat = cos(subSolarLatitude);
-            const double sinsslat = sin(subSolarLatitude);
-
-            const double sinAlt = sin(sunAltitude);
-            const double cosAlt = cos(sunAltitude);
-
-            // Precalculate unvarying quantities:
-            double sinBPart = sinsslat*sinAlt;
-            double yPart = cosAlt*cossslat;
-            
-            double lastLatitude;
-            double lastLongitude;
-            int latitudeIndex;
-            double latitudeForLatitudeIndex;
-            
-            bool firstTime = true;
-            bool lastTime = false;
-
-            for (int i = 0; i < NUM_PARAMETRIC_POINTS; i++) {
-                lastTime = false;
-                double psi = i * (M_PI / (NUM_PARAMETRIC_POINTS - 1)) - M_PI/2;
-                
-                double sinB = sinBPart + yPart*sin(psi);
-                double x = sinAlt - sinsslat*sinB;
-                double B = asin(sinB);      // B is the latitude the parameteric curve gives at this iteration
-                double y = yPart*cos(psi);
-                double L = atan2(y, x);     // and L is the longitude
-                if (L > M_PI) {
-                    L -= 2 * M_PI;
-                } else if (L < -M_PI) {
-                    L += 2 * M_PI;
-                }
-                ESAssert(L >= 0);  // Otherwise we should flip the sign, but worry that the entire table has to flip at the same time
-                //tracePrintf("");
-                //traceAngle(psi, "psi");
-                //traceAngle(B, "B (latitude)");
-                //traceAngle(L, "L (longitude)");
-                
-                // A latitude index maps to a given latitude.  We want to put the best possible value in that slot, which will be the interpolation between two
-                // latitude values before and after the value.  So we remember the previous value as we move forward, and once we cross over a new value, we insert
-                // into that slot the appropriate interpolated longitude.
-                if (firstTime) {
-                    firstTime = false;
-                    int newLatitudeIndex = ES_LAT_TO_INDEX(B);
-                    ESAssert(newLatitudeIndex >= 0 && newLatitudeIndex < ES_LATITUDE_SLOTS);
-                    for (latitudeIndex = 0; latitudeIndex < newLatitudeIndex; latitudeIndex++) {
-                        altitudeMapTable->rowDataForLatitude[latitudeIndex].longitudeForAltitude[altitudeIndex] =
-                            infinityForSSLatAlt(subSolarLatitude, ES_INDEX_TO_LAT(latitudeIndex), sunAltitude);
-                    }
-                    ESAssert(latitudeIndex == newLatitudeIndex);
-                    altitudeMapTable->rowDataForLatitude[latitudeIndex].longitudeForAltitude[altitudeIndex] = L;
-                    latitudeForLatitudeIndex = ES_INDEX_TO_LAT(latitudeIndex);
-                    if (B > latitudeForLatitudeIndex) {  // We're passed it, so we've done the best we can do there; move on
-                        latitudeIndex++;
-                        latitudeForLatitudeIndex = ES_INDEX_TO_LAT(latitudeIndex);
-                    } else {
-                        // Otherwise we can still do better for this slot, since we should later get spanning latitudes for this slot between which we can
-                        // interpolate, so leave latitudeIndex as is
-                    }
-                } else {
-                    ESAssert(B > lastLatitude);
-//                    ESAssert(fabs(L-lastLongitude) < .001);
-                    while (B > latitudeForLatitudeIndex) {
-                        // Interpolate between the two latitudes, set the value, advance
-                        double interpolatedLongitude = lastLongitude + (latitudeForLatitudeIndex - lastLatitude)/(B - lastLatitude) * (L - lastLongitude);
-                        ESAssert(latitudeIndex < ES_LATITUDE_SLOTS);
-                        altitudeMapTable->rowDataForLatitude[latitudeIndex].longitudeForAltitude[altitudeIndex] = interpolatedLongitude;
-                        latitudeIndex++;
-                        ESAssert(latitudeIndex < ES_LATITUDE_SLOTS);  // B > M_PI/2 ? 
-                        latitudeForLatitudeIndex = ES_INDEX_TO_LAT(latitudeIndex);
-                        if (B > latitudeForLatitudeIndex) {
-                            printf("Seem to not have enough parameteric points; try increasing NUM_PARAMETRIC_POINTS\n");
-                        }
-                    }
-                    if (i == NUM_PARAMETRIC_POINTS-1) {  // Last time
-                        // Last chance -- fill in last one
-                        int newLatitudeIndex = ES_LAT_TO_INDEX(B);
-                        if (newLatitudeIndex == latitudeIndex) {
-                            // By the while loop exit above, B is <= latitudeForLatitudeIndex, but still we round to the same value, so we can fill in the long here
-                            // directly cause this is the closest we're ever going to get
-                            altitudeMapTable->rowDataForLatitude[latitudeIndex].longitudeForAltitude[altitudeIndex] = L;
-                        } else {
-                            ESAssert(newLatitudeIndex < latitudeIndex);
-                            // If we're here, it means that we rounded down below the latitudeIndex we're trying to get, so ignore it; we already set the previous
-                            // index to what presumably was the best value for that index
-                        }
-                        // Now fill in with positive infinity with everything left
-                        while (latitudeIndex < ES_LATITUDE_SLOTS) {
-                            altitudeMapTable->rowDataForLatitude[latitudeIndex].longitudeForAltitude[altitudeIndex] =
-                                infinityForSSLatAlt(subSolarLatitude, ES_INDEX_TO_LAT(latitudeIndex), sunAltitude);
-                            latitudeIndex++;
-                        }
-                        lastTime = true;
-                    }
-                }
-                lastLatitude = B;
-                lastLongitude = L;
+    traceEnter3("ESSunAltitudeTable::fillInFromScratch ss%d-lat%d-alt%d", subsolarSlots(), latitudeSlots(), altitudeSlots());
+    tracePrintf1("table size is %ld", dataSize());
+
+    float *longitudes = _longitudes;
+    for (int subsolarIndex = 0; subsolarIndex < subsolarSlots(); subsolarIndex++) {
+        double subSolarLatitude = subsolarLatitudeForIndex(subsolarIndex);
+        ESAssert(subSolarLatitude >= 0);  // If ssLat is < 0, flip the sign of the input latitude when looking up values
+        for (int latitudeIndex = 0; latitudeIndex < latitudeSlots(); latitudeIndex++) {
+            double latitude = latitudeForIndex(latitudeIndex);
+            for (int altitudeIndex = 0; altitudeIndex < altitudeSlots(); altitudeIndex++) {
+                *longitudes++ = longitudeForAltitude(subSolarLatitude, latitude, altitudeForIndex(altitudeIndex));
             }
-            ESAssert(lastTime);
         }
-        traceExit1("subSolar index %d", subsolarIndex);
     }
+    ESAssert(longitudes == _longitudes + dataSize() / sizeof(float));
+    header()->checksum = checksumForData(_longitudes, dataSize());
+
     traceExit("ESSunAltitudeTable::fillInFromScratch");
 }
 
 
 void 
-ESSunAltitudeTable::interpolateRowData(float                        subsolarLatitude,
-                                       int                          mapLatitudeIndex,
-                                       ESSunAltitudeLatitudeRowData *rowData) const {
-    //traceEnter3("interpolateRowData for ssLat %.2f, mapLat %d(%.2f)", subsolarLatitude*180/M_PI, mapLatitudeIndex, ES_INDEX_TO_LAT(mapLatitudeIndex)*180/M_PI);
+ESSunAltitudeTable::interpolateRowData(float subsolarLatitude,
+                                       int   mapLatitudeIndex,
+                                       float *longitudeForAltitude) const {
+    //traceEnter3("interpolateRowData for ssLat %.2f, mapLat %d(%.2f)", subsolarLatitude*180/M_PI, mapLatitudeIndex, latitudeForIndex(mapLatitudeIndex)*180/M_PI);
     int beforeSSLatIndex;
-    int afterSSLatIndex;
-    bool flipLatitude = getInterpolatedSSLatIndex(subsolarLatitude, &beforeSSLatIndex, &afterSSLatIndex);
-    const ESSunAltitudeMapTable *beforeMapTable = &_altitudeMapForSubSolarLatitude[beforeSSLatIndex];
-    const ESSunAltitudeMapTable *afterMapTable = &_altitudeMapForSubSolarLatitude[afterSSLatIndex];
+    float afterWeight;
+    bool flipLatitude = getInterpolatedSSLatIndex(subsolarLatitude, _dimensions.subsolarSteps, &beforeSSLatIndex, &afterWeight);
 
     if (flipLatitude) {
-        mapLatitudeIndex = ES_LATITUDE_STEPS - mapLatitudeIndex;  // aka (ES_LATITUDE_SLOTS-1) - mapLatitudeIndex
+        mapLatitudeIndex = _dimensions.latitudeSteps - mapLatitudeIndex;  // aka (latitudeSlots()-1) - mapLatitudeIndex
     }
 
-    float *outputPtr = rowData->longitudeForAltitude;
-    const float *stopPtr = outputPtr + ES_ALTITUDE_SLOTS;
+    float *outputPtr = longitudeForAltitude;
+    const float *stopPtr = outputPtr + altitudeSlots();
 
-    const float *ptrB = beforeMapTable->rowDataForLatitude[mapLatitudeIndex].longitudeForAltitude;
-    const float *ptrA =  afterMapTable->rowDataForLatitude[mapLatitudeIndex].longitudeForAltitude;
+    const float *ptrB = rowData(beforeSSLatIndex, mapLatitudeIndex);
+    const float *ptrA = rowData(beforeSSLatIndex + 1, mapLatitudeIndex);
 
     while (outputPtr < stopPtr) {
-        *outputPtr++ = (*ptrA++ + *ptrB++) / 2;
+        float before = *ptrB++;
+        *outputPtr++ = before + afterWeight * (*ptrA++ - before);
         //tracePrintf3("interpolateRowData combined %.2f %.2f and got %.2f", ptrB[-1]*180/M_PI, ptrA[-1]*180/M_PI, outputPtr[-1]*180/M_PI);
     }
     //traceExit("interpolateRowData");
 }
 
+// The opacity at a pixel is the sum over altitude bands of how far across that band the pixel's distance in longitude from the
+// subsolar point lies, clamped to the band:  each band is a ramp from 0 to 1/altitudeSteps between the longitudes for the
+// altitudes at its two ends.  Doing it band by band over the whole row, rather than pixel by pixel, keeps the inner loops free
+// of branches and table lookups so that they vectorize.
+static void addBandOpacities(const float *longitudes,
+                             int         altitudeSteps,
+                             float       bandOpacity,
+                             const float *columnLongitudes,
+                             int         width,
+                             float       *opacity) {
+    for (int altitudeIndex = 0; altitudeIndex < altitudeSteps; altitudeIndex++) {
+        float bandStart = longitudes[altitudeIndex];
+        float bandEnd = longitudes[altitudeIndex + 1];
+        if (bandEnd > bandStart) {
+            float slope = bandOpacity / (bandEnd - bandStart);
+            for (int column = 0; column < width; column++) {
+                float bandPart = (columnLongitudes[column] - bandStart) * slope;
+                bandPart = bandPart < 0 ? 0 : bandPart;
+                bandPart = bandPart > bandOpacity ? bandOpacity : bandPart;
+                opacity[column] += bandPart;
+            }
+        } else {  // A band of no width is a step
+            for (int column = 0; column < width; column++) {
+                opacity[column] += columnLongitudes[column] >= bandStart ? bandOpacity : 0;
+            }
+        }
+    }
+}
+
+// The longitudes for each altitude at a map latitude between slots, interpolated from the four table entries around it
+// (the bracketing subsolar latitude slots and map latitude slots) with their linear weights.  Where some of the four are
+// pinned at 0 or pi (the Sun never gets that high or low there) and others aren't, which happens only near the edges of
+// polar day and night, interpolating would leave bands across the mask, so those entries are solved for directly.
+void
+ESSunAltitudeTable::interpolateLongitudes(double subsolarLatitude,
+                                          double mapLatitude,
+                                          float  *longitudes) const {
+    int beforeSSLatIndex;
+    float ssLatAfterWeight;
+    if (getInterpolatedSSLatIndex(subsolarLatitude, _dimensions.subsolarSteps, &beforeSSLatIndex, &ssLatAfterWeight)) {
+        mapLatitude = -mapLatitude;
+    }
+    int beforeLatIndex;
+    float latAfterWeight;
+    getInterpolatedIndex((mapLatitude + M_PI/2) * _dimensions.latitudeSteps / M_PI, _dimensions.latitudeSteps, &beforeLatIndex, &latAfterWeight);
+    // Named by subsolar slot then map latitude slot, B for before and A for after
+    const float *rowBB = rowData(beforeSSLatIndex, beforeLatIndex);
+    const float *rowBA = rowData(beforeSSLatIndex, beforeLatIndex + 1);
+    const float *rowAB = rowData(beforeSSLatIndex + 1, beforeLatIndex);
+    const float *rowAA = rowData(beforeSSLatIndex + 1, beforeLatIndex + 1);
+    const float pinnedHighValue = (float)M_PI;  // as stored
+    for (int altitudeIndex = 0; altitudeIndex < altitudeSlots(); altitudeIndex++) {
+        float bb = rowBB[altitudeIndex];
+        float ba = rowBA[altitudeIndex];
+        float ab = rowAB[altitudeIndex];
+        float aa = rowAA[altitudeIndex];
+        int pinnedLow = (bb == 0) + (ba == 0) + (ab == 0) + (aa == 0);
+        int pinnedHigh = (bb == pinnedHighValue) + (ba == pinnedHighValue) + (ab == pinnedHighValue) + (aa == pinnedHighValue);
+        if ((pinnedLow != 0 && pinnedLow != 4) || (pinnedHigh != 0 && pinnedHigh != 4)) {
+            longitudes[altitudeIndex] = longitudeForAltitude(fabs(subsolarLatitude), mapLatitude, altitudeForIndex(altitudeIndex));
+        } else {
+            float before = bb + latAfterWeight * (ba - bb);
+            float after = ab + latAfterWeight * (aa - ab);
+            longitudes[altitudeIndex] = before + ssLatAfterWeight * (after - before);
+        }
+    }
+}
+
+void
+ESSunAltitudeTable::renderMaskRow(double        subsolarLatitude,
+                                  double        mapLatitude,
+                                  const float   *columnLongitudes,
+                                  int           width,
+                                  unsigned char *output,
+                                  int           levelCount) const {
+    std::vector<float> longitudes(altitudeSlots());
+    std::vector<float> opacities(width);
+    float *opacity = &opacities[0];
+    interpolateLongitudes(subsolarLatitude, mapLatitude, &longitudes[0]);
+    for (int column = 0; column < width; column++) {
+        opacity[column] = 0;
+    }
+    addBandOpacities(&longitudes[0], _dimensions.altitudeSteps, 1.0f / _dimensions.altitudeSteps, columnLongitudes, width, opacity);
+    // Both conversions clamp in integers, which vectorizes where clamping in floats doesn't
+    if (levelCount >= 2) {
+        // Round any twilight up to the next level, allowing for roundoff in the sum for full night
+        const int maxLevel = levelCount - 1;
+        const float levelSteps = maxLevel;
+        const float levelOpacity = 255.0f / levelSteps;
+        for (int column = 0; column < width; column++) {
+            int level = (int)(opacity[column] * levelSteps + 0.9999f);
+            level = level > maxLevel ? maxLevel : level;
+            output[column] = (unsigned char)(int)(level * levelOpacity + 0.5f);
+        }
+    } else {
+        for (int column = 0; column < width; column++) {
+            int value = (int)(opacity[column] * 255 + 0.5f);
+            output[column] = (unsigned char)(value > 255 ? 255 : value);
+        }
+    }
+}
+
+void
+ESSunAltitudeTable::renderMaskRows(const float   *columnLongitudes,
+                                   double        subsolarLatitude,
+                                   int           width,
+                                   int           height,
+                                   int           firstRow,
+                                   int           lastRow,
+                                   unsigned char *mask,
+                                   size_t        bytesPerRow,
+                                   int           levelCount) const {
+    for (int row = firstRow; row < lastRow; row++) {
+        renderMaskRow(subsolarLatitude, M_PI/2 - (row + 0.5) * M_PI / height, columnLongitudes, width, mask + row * bytesPerRow, levelCount);
+    }
+}
+
+#define ES_MASK_MIN_PIXELS_PER_THREAD 65536
+
+void
+ESSunAltitudeTable::renderMask(double        subsolarLatitude,
+                               double        subsolarLongitude,
+                               int           width,
+                               int           height,
+                               unsigned char *mask,
+                               size_t        bytesPerRow,
+                               int           levelCount,
+                               int           threadCount) const {
+    ESAssert(width > 0 && height > 0);
+    ESAssert(bytesPerRow >= (size_t)width);
+    // Every row sees the same distance in longitude from the subsolar point at a given column
+    std::vector<float> columnLongitudes(width);
+    for (int column = 0; column < width; column++) {
+        columnLongitudes[column] = fabs(remainder(-M_PI + (column + 0.5) * 2 * M_PI / width - subsolarLongitude, 2 * M_PI));
+    }
+
+    if (threadCount <= 0) {
+        threadCount = std::thread::hardware_concurrency();
+    }
+    int maxThreads = (int)((double)width * height / ES_MASK_MIN_PIXELS_PER_THREAD);
+    if (threadCount > maxThreads) {
+        threadCount = maxThreads;
+    }
+    if (threadCount > height) {
+        threadCount = height;
+    }
+    if (threadCount <= 1) {
+        renderMaskRows(&columnLongitudes[0], subsolarLatitude, width, height, 0, height, mask, bytesPerRow, levelCount);
+        return;
+    }
+    std::vector<std::thread> workers;
+    workers.reserve(threadCount - 1);
+    int band = (height + threadCount - 1) / threadCount;
+    for (int firstRow = band; firstRow < height; firstRow += band) {
+        int lastRow = firstRow + band < height ? firstRow + band : height;
+        workers.push_back(std::thread(&ESSunAltitudeTable::renderMaskRows, this, &columnLongitudes[0], subsolarLatitude,
+                                      width, height, firstRow, lastRow, mask, bytesPerRow, levelCount));
+    }
+    renderMaskRows(&columnLongitudes[0], subsolarLatitude, width, height, 0, band, mask, bytesPerRow, levelCount);
+    for (size_t i = 0; i < workers.size(); i++) {
+        workers[i].join();
+    }
+}
+
+void 
+ESSunAltitudeTable::interpolateRowData(float                        subsolarLatitude,
+                                       int                          mapLatitudeIndex,
+                                       ESSunAltitudeLatitudeRowData *rowData) const {
+    ESAssert(_dimensions == ESSunAltitudeTableDimensions::defaultDimensions());
+    interpolateRowData(subsolarLatitude, mapLatitudeIndex, rowData->longitudeForAltitude);
+}
+
 void
 ESSunAltitudeTable::serializeToFile() {
-    SETUP_TABLE_FILE_NAME
-    bool st = ESFile::writeArrayToFile(this, sizeof(*this), ES_TABLE_FILE, ESFilePathTypeRelativeToAppSupportDir);
+    char fileName[ES_TABLE_FILE_NAME_SIZE];
+    getFileName(_dimensions, fileName, sizeof(fileName));
+    // The header goes too, so the file can be mapped with createByMappingFile
+    const ESSunAltitudeTableFileHeader *fileHeader = (const ESSunAltitudeTableFileHeader *)_storage;
+    bool st = ESFile::writeArrayToFile(_storage, fileHeader->headerSize + dataSize(), fileName, ESFilePathTypeRelativeToAppSupportDir);
     if (st) {
-        ESErrorReporter::logInfo("ESSunAltitudeTable", "Successfully wrote to table file %s\n", ES_TABLE_FILE);
+        ESErrorReporter::logInfo("ESSunAltitudeTable", "Successfully wrote to table file %s\n", fileName);
     } else {
-        ESErrorReporter::logError("ESSunAltitudeTable", "Failed to write to table file %s\n", ES_TABLE_FILE);
+        ESErrorReporter::logError("ESSunAltitudeTable", "Failed to write to table file %s\n", fileName);
     }
 }
 
 #ifdef ESTRACE
 void 
 ESSunAltitudeTable::printTable() {
-    traceEnter1("Sun altitude table (%d subsolar slot pages)", ES_SUBSOLAR_SLOTS);
-    for (int subsolarIndex = 0; subsolarIndex < ES_SUBSOLAR_SLOTS; subsolarIndex++) {
-        traceEnter3("Subsolar page %3d (subsolar latitude %6.2f degrees), %d latitude slots", subsolarIndex, ES_INDEX_TO_SUBSOLAR(subsolarIndex) * 180 / M_PI, ES_LATITUDE_SLOTS);
-        ESSunAltitudeMapTable *mapTable = &_altitudeMapForSubSolarLatitude[subsolarIndex];
-        for (int latitudeIndex = 0; latitudeIndex < ES_LATITUDE_SLOTS; latitudeIndex++) {
-            traceEnter3("Latitude index %3d (latitude %6.2f degrees), %d altitude slots", latitudeIndex, ES_INDEX_TO_LAT(latitudeIndex) * 180 / M_PI, ES_ALTITUDE_SLOTS);
-            ESSunAltitudeLatitudeRowData *rowData = &mapTable->rowDataForLatitude[latitudeIndex];
-            for (int altitudeIndex = 0; altitudeIndex < ES_ALTITUDE_SLOTS; altitudeIndex++) {
+    traceEnter1("Sun altitude table (%d subsolar slot pages)", subsolarSlots());
+    for (int subsolarIndex = 0; subsolarIndex < subsolarSlots(); subsolarIndex++) {
+        traceEnter3("Subsolar page %3d (subsolar latitude %6.2f degrees), %d latitude slots", subsolarIndex, subsolarLatitudeForIndex(subsolarIndex) * 180 / M_PI, latitudeSlots());
+        for (int latitudeIndex = 0; latitudeIndex < latitudeSlots(); latitudeIndex++) {
+            traceEnter3("Latitude index %3d (latitude %6.2f degrees), %d altitude slots", latitudeIndex, latitudeForIndex(latitudeIndex) * 180 / M_PI, altitudeSlots());
+            const float *longitudes = rowData(subsolarIndex, latitudeIndex);
+            for (int altitudeIndex = 0; altitudeIndex < altitudeSlots(); altitudeIndex++) {
                 tracePrintf3("Altitude index %3d (altitude %6.2f degrees) => longitude %7.2f degrees",
-                             altitudeIndex, ES_INDEX_TO_ALT(altitudeIndex) * 180 / M_PI, rowData->longitudeForAltitude[altitudeIndex] * 180 / M_PI);
+                             altitudeIndex, altitudeForIndex(altitudeIndex) * 180 / M_PI, longitudes[altitudeIndex] * 180 / M_PI);
             }
-            traceExit2("Latitude index %d (latitude %6.2f degrees)", latitudeIndex, ES_INDEX_TO_LAT(latitudeIndex) * M_PI / 180);
+            traceExit2("Latitude index %d (latitude %6.2f degrees)", latitudeIndex, latitudeForIndex(latitudeIndex) * M_PI / 180);
         }
-        traceExit2("Subsolar page %d (subsolar latitude %6.2f degrees)", subsolarIndex, ES_INDEX_TO_SUBSOLAR(subsolarIndex) * M_PI / 180);
+        traceExit2("Subsolar page %d (subsolar latitude %6.2f degrees)", subsolarIndex, subsolarLatitudeForIndex(subsolarIndex) * M_PI / 180);
     }
     traceExit("\nSun altitude table\n");
 }
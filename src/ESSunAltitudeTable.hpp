@@ -8,6 +8,11 @@
 #ifndef _ESSUNALTITUDETABLE_HPP_
 #define _ESSUNALTITUDETABLE_HPP_
 
+#include <stddef.h>  // For size_t
+#include <stdint.h>
+
+// These select the dimensions of the default table, which is the one shipped as a resource file.  Tables of other dimensions
+// can be created at runtime (see ESSunAltitudeTableDimensions below) and used side by side with it.
 #undef ES_HUGE_TABLE
 #define ES_LARGE_TABLE
 #undef ES_MEDIUM_TABLE
@@ -38,6 +43,7 @@
 #define ES_SUBSOLAR_SLOTS (ES_SUBSOLAR_STEPS + 1)
 
 
+// The following index macros apply to the default table only; tables with other dimensions have equivalent member functions.
 // The following is *map* latitude, not sslat
 #define ES_LAT_TO_INDEX(B) (round((B + M_PI/2)/M_PI * ES_LATITUDE_STEPS))  // Note: STEPS not SLOTS -- we have a slot for M_PI/2 at the end
 #define ES_INDEX_TO_LAT(I) (-M_PI/2 + (I * M_PI / ES_LATITUDE_STEPS))
@@ -61,28 +67,118 @@
 #define ES_INDEX_TO_ALT(I) (ES_ALT_MAX - (I * ES_ALT_RANGE / ES_ALTITUDE_STEPS))
 
 
-// This struct represents a single row of data for a single location latitude within a table for a given subsolar latitude
+// This struct represents a single row of data for a single location latitude within a default-sized table for a given subsolar latitude
 struct ESSunAltitudeLatitudeRowData {
     float                   longitudeForAltitude[ES_ALTITUDE_SLOTS];
 };
 
-// This struct contains all of the required data for a given subsolar latitude
-struct ESSunAltitudeMapTable {
-    ESSunAltitudeLatitudeRowData rowDataForLatitude[ES_LATITUDE_SLOTS];
+// The dimensions and altitude range of a table.  The number of slots in each dimension is one more than the number of steps.
+struct ESSunAltitudeTableDimensions {
+    int                     subsolarSteps;        // over subsolar latitudes 0 thru ES_SUBSOLAR_MAX
+    int                     latitudeSteps;        // over map latitudes -pi/2 thru pi/2
+    int                     altitudeSteps;        // over Sun altitudes ES_ALT_MAX down thru altitudeMinDegrees
+    int                     altitudeMinDegrees;
+
+    // The dimensions selected by the ES_*_TABLE macros above
+    static ESSunAltitudeTableDimensions defaultDimensions() {
+        ESSunAltitudeTableDimensions dimensions = { ES_SUBSOLAR_STEPS, ES_LATITUDE_STEPS, ES_ALTITUDE_STEPS, ES_ALT_MIN_DEGREES };
+        return dimensions;
+    }
+    bool                    operator==(const ESSunAltitudeTableDimensions &other) const {
+        return subsolarSteps == other.subsolarSteps && latitudeSteps == other.latitudeSteps &&
+            altitudeSteps == other.altitudeSteps && altitudeMinDegrees == other.altitudeMinDegrees;
+    }
+};
+
+// Table files start with this header, followed at headerSize by the data in the layout described below.  Tables in memory
+// have the same header in front of their data, so a file can be mapped and used in place.
+#define ES_SUN_ALTITUDE_TABLE_FILE_MAGIC "ESSunAlt"
+#define ES_SUN_ALTITUDE_TABLE_FILE_VERSION 1
+#define ES_SUN_ALTITUDE_TABLE_BYTE_ORDER_MARK 0x01020304
+
+struct ESSunAltitudeTableFileHeader {
+    char                    magic[8];             // ES_SUN_ALTITUDE_TABLE_FILE_MAGIC, without the null
+    uint32_t                byteOrderMark;        // ES_SUN_ALTITUDE_TABLE_BYTE_ORDER_MARK in the writer's byte order
+    uint32_t                version;              // ES_SUN_ALTITUDE_TABLE_FILE_VERSION
+    uint32_t                headerSize;           // Offset of the data from the start of the file; a multiple of 64
+    int32_t                 subsolarSteps;        // These four are the ESSunAltitudeTableDimensions
+    int32_t                 latitudeSteps;
+    int32_t                 altitudeSteps;
+    int32_t                 altitudeMinDegrees;
+    uint32_t                checksum;             // Adler-32 of the data bytes as stored
+    uint64_t                dataSize;             // In bytes
+    uint8_t                 reserved[16];         // Zero
 };
 
 /** This class gives a means of determining the longitudes at which the Sun is at a particular altitude, given a latitude and a subsolar location.
  *  It is intended for Emerald Observatory's Earth Map display showing the light and dark regions of the Earth.
- *  The idea is that given a subsolar latitude, one can then calculate, by successive approximation of a parametric formula,
+ *  The idea is that given a subsolar latitude, one can then calculate directly, from the altitude formula solved for hour angle,
  *  the longitude at which the given altitude appears.  We record that longitude in a table by altitude, for a given latitude and subsolar latitude.
  *  Once we have the table (which we can serialize to disk and then deserialize to read it back in during a later session) we can then do an
  *  interpolation in the table to determine the proper longitude for a given set of data.
+ *  The dimensions are chosen when the table is created, so a coarse table for thumbnails and a fine one for full-size maps can be
+ *  loaded at once.  The data is one contiguous, aligned array of floats, by subsolar latitude, then map latitude, then altitude,
+ *  which is the same layout the fixed-size table used to have.  createFromFile still reads the older files that have only the data
+ *  and no header; createByMappingFile needs the header, and in exchange shares the file's pages with every process that maps it.
 */
 class ESSunAltitudeTable {
   public:
-    static ESSunAltitudeTable *createFromFile();
-    static ESSunAltitudeTable *createFromScratch();
-
+    static ESSunAltitudeTable *createFromFile(const ESSunAltitudeTableDimensions &dimensions = ESSunAltitudeTableDimensions::defaultDimensions());
+    // Maps the table file with these dimensions in the given directory read-only, so there is no copy at load time and all
+    // processes mapping it share one physical copy.  Checking the checksum reads every page once.
+    static ESSunAltitudeTable *createByMappingFile(const char                         *directoryPath,
+                                                   const ESSunAltitudeTableDimensions &dimensions = ESSunAltitudeTableDimensions::defaultDimensions(),
+                                                   bool                               verifyChecksum = true);
+    static ESSunAltitudeTable *createFromScratch(const ESSunAltitudeTableDimensions &dimensions = ESSunAltitudeTableDimensions::defaultDimensions());
+                            ~ESSunAltitudeTable();
+
+    const ESSunAltitudeTableDimensions &dimensions() const { return _dimensions; }
+    int                     subsolarSlots() const { return _dimensions.subsolarSteps + 1; }
+    int                     latitudeSlots() const { return _dimensions.latitudeSteps + 1; }
+    int                     altitudeSlots() const { return _dimensions.altitudeSteps + 1; }
+
+    // These are the member-function equivalents of the ES_INDEX_TO_* and ES_LAT_TO_INDEX macros, for this table's dimensions
+    double                  subsolarLatitudeForIndex(int subsolarIndex) const;
+    double                  latitudeForIndex(int mapLatitudeIndex) const;
+    int                     indexForLatitude(double mapLatitude) const;
+    double                  altitudeForIndex(int altitudeIndex) const;
+
+    // The altitudeSlots() entries for one subsolar latitude slot and map latitude slot
+    const float             *rowData(int subsolarIndex,
+                                     int mapLatitudeIndex) const {
+        return _longitudes + ((size_t)subsolarIndex * latitudeSlots() + mapLatitudeIndex) * altitudeSlots();
+    }
+
+    // Fills altitudeSlots() floats at longitudeForAltitude, interpolating linearly between the bracketing subsolar latitude slots
+    void                    interpolateRowData(float                        subsolarLatitude,
+                                               int                          mapLatitudeIndex,
+                                               float                        *longitudeForAltitude) const;
+
+    // Renders the night overlay for the whole Earth in equirectangular projection:  longitude -pi thru pi from left to right,
+    // latitude pi/2 thru -pi/2 from top to bottom, with pixel centers half a pixel in.  Each byte is the overlay's opacity:  0 where
+    // the Sun is up, 255 where it is below the table's lowest altitude, and across the twilight between in proportion to the
+    // Sun's altitude.  With levelCount >= 2 the opacity is quantized to that many levels, rounding any twilight up, so 2 gives a
+    // plain day/night mask.  Each row's longitudes come from the table, interpolated with linear weights between the subsolar
+    // latitude slots and map latitude slots around it.  Bands of rows are rendered on threadCount threads (0 => one per core).
+    void                    renderMask(double        subsolarLatitude,
+                                       double        subsolarLongitude,
+                                       int           width,
+                                       int           height,
+                                       unsigned char *mask,
+                                       size_t        bytesPerRow,
+                                       int           levelCount = 0,
+                                       int           threadCount = 0) const;
+
+    // Renders one row of such a mask at the given map latitude, for any projection in which rows are parallels.  Each column's
+    // longitude is given as its distance east or west of the subsolar point (0 thru pi).
+    void                    renderMaskRow(double        subsolarLatitude,
+                                          double        mapLatitude,
+                                          const float   *columnLongitudes,
+                                          int           width,
+                                          unsigned char *output,
+                                          int           levelCount = 0) const;
+
+    // Only for tables with the default dimensions
     void                    interpolateRowData(float                        subsolarLatitude,
                                                int                          mapLatitudeIndex,
                                                ESSunAltitudeLatitudeRowData *rowData) const;
@@ -91,11 +187,50 @@ class ESSunAltitudeTable {
 
     void                    printTable();  // Only available if ESTRACE turned on in .cpp file
 
+    // The longitude east or west of the subsolar point (0 thru pi) at which the Sun has the given altitude at the given map
+    // latitude:  0 if the Sun never gets that high there, pi if it never gets that low.  This is what each table entry holds.
+    static double           longitudeForAltitude(double subsolarLatitude,
+                                                 double mapLatitude,
+                                                 double sunAltitude);
+
   private:
-                            ESSunAltitudeTable() {}
+                            ESSunAltitudeTable(void   *storage,
+                                               size_t mappedSize);
+    // Not copyable, since the destructor frees or unmaps _storage
+                            ESSunAltitudeTable(const ESSunAltitudeTable &) = delete;
+    ESSunAltitudeTable      &operator=(const ESSunAltitudeTable &) = delete;
     void                    fillInFromScratch();
-
-    ESSunAltitudeMapTable   _altitudeMapForSubSolarLatitude[ES_SUBSOLAR_SLOTS];
+    void                    renderMaskRows(const float   *columnLongitudes,
+                                           double        subsolarLatitude,
+                                           int           width,
+                                           int           height,
+                                           int           firstRow,
+                                           int           lastRow,
+                                           unsigned char *mask,
+                                           size_t        bytesPerRow,
+                                           int           levelCount) const;
+    void                    interpolateLongitudes(double subsolarLatitude,
+                                                  double mapLatitude,
+                                                  float  *longitudes) const;
+    ESSunAltitudeTableFileHeader *header() { return (ESSunAltitudeTableFileHeader *)_storage; }
+    size_t                  dataSize() const { return dataSizeForDimensions(_dimensions); }
+    static size_t           dataSizeForDimensions(const ESSunAltitudeTableDimensions &dimensions);
+    static void             *allocateStorage(const ESSunAltitudeTableDimensions &dimensions);
+    static bool             validateHeader(const ESSunAltitudeTableFileHeader *header,
+                                           size_t                             fileSize,
+                                           const ESSunAltitudeTableDimensions &dimensions,
+                                           bool                               verifyChecksum,
+                                           const char                         *fileName);
+    static uint32_t         checksumForData(const void *data,
+                                            size_t     dataSize);
+    static void             getFileName(const ESSunAltitudeTableDimensions &dimensions,
+                                        char                               *fileName,
+                                        size_t                             fileNameSize);
+
+    ESSunAltitudeTableDimensions _dimensions;
+    void                    *_storage;     // The header, followed by the data
+    float                   *_longitudes;  // The data, within _storage
+    size_t                  _mappedSize;   // Nonzero iff _storage is mmapped rather than malloc'd
 };
 
 #endif  // _ESSUNALTITUDETABLE_HPP_
@@ -0,0 +1,202 @@
+//
+//  ESSunAltitudeTileCache.cpp
+//
+//  Created 18 Oct 2026
+//  Copyright Emerald Sequoia LLC 2026. All rights reserved.
+//
+
+#include "ESSunAltitudeTileCache.hpp"
+#include "ESSunAltitudeTable.hpp"
+
+#include "ESErrorReporter.hpp"
+
+#include <math.h>
+#include <string.h>
+
+ESSunAltitudeTileCache::ESSunAltitudeTileCache(const ESSunAltitudeTable *table,
+                                               int                      tileSize,
+                                               int                      levelCount,
+                                               size_t                   maxTiles)
+:   _table(table),
+    _tileSize(tileSize),
+    _levelCount(levelCount),
+    _maxTiles(maxTiles)
+{
+    ESAssert(table);
+    ESAssert(tileSize > 0);
+    ESAssert(maxTiles > 0);
+}
+
+static double mercatorLatitude(double tileY,  // Fractional, in tiles from the top
+                               int    tilesPerSide) {
+    return atan(sinh(M_PI * (1 - 2 * tileY / tilesPerSide)));
+}
+
+// The largest value of A sin(lat) + B cos(lat) over the latitude range; negate A, B and the result for the smallest
+static double maxOverLatitudes(double A,
+                               double B,
+                               double southLatitude,
+                               double northLatitude) {
+    double atSouth = A * sin(southLatitude) + B * cos(southLatitude);
+    double atNorth = A * sin(northLatitude) + B * cos(northLatitude);
+    double maxValue = atSouth > atNorth ? atSouth : atNorth;
+    double peakLatitude = atan2(A, B);  // where the sinusoid peaks at sqrt(A*A + B*B)
+    if (peakLatitude >= southLatitude && peakLatitude <= northLatitude) {
+        maxValue = sqrt(A * A + B * B);
+    }
+    return maxValue;
+}
+
+// The Sun's altitude h at latitude B and hour angle H satisfies sin h = sin B sin sslat + cos B cos sslat cos H.  Since
+// cos B cos sslat is never negative, over the tile sin h is largest where cos H is, and smallest where cos H is; so we take
+// the extremes of cos H over the tile's longitudes and then the extremes over its latitudes of the resulting sinusoid in B.
+ESSunAltitudeTileCache::TileCoverage
+ESSunAltitudeTileCache::coverageForTile(const ESSunAltitudeTileKey &key,
+                                        double                     subsolarLatitude,
+                                        double                     subsolarLongitude) const {
+    int tilesPerSide = 1 << key.zoom;
+    double tileWidth = 2 * M_PI / tilesPerSide;
+    double westHourAngle = remainder(-M_PI + key.x * tileWidth - subsolarLongitude, 2 * M_PI);  // -pi thru pi
+    double eastHourAngle = westHourAngle + tileWidth;
+    double maxCosHourAngle = fmax(cos(westHourAngle), cos(eastHourAngle));
+    double minCosHourAngle = fmin(cos(westHourAngle), cos(eastHourAngle));
+    if ((westHourAngle <= 0 && eastHourAngle >= 0) || eastHourAngle >= 2 * M_PI) {
+        maxCosHourAngle = 1;
+    }
+    if (eastHourAngle >= M_PI || westHourAngle <= -M_PI) {
+        minCosHourAngle = -1;
+    }
+    double northLatitude = mercatorLatitude(key.y, tilesPerSide);
+    double southLatitude = mercatorLatitude(key.y + 1, tilesPerSide);
+    double sinSubsolarLatitude = sin(subsolarLatitude);
+    double cosSubsolarLatitude = cos(subsolarLatitude);
+    double minSinAltitude = -maxOverLatitudes(-sinSubsolarLatitude, -cosSubsolarLatitude * minCosHourAngle, southLatitude, northLatitude);
+    if (minSinAltitude > sin(ES_ALT_MAX)) {
+        return TileAllDay;
+    }
+    double maxSinAltitude = maxOverLatitudes(sinSubsolarLatitude, cosSubsolarLatitude * maxCosHourAngle, southLatitude, northLatitude);
+    if (maxSinAltitude < sin(_table->altitudeForIndex(_table->dimensions().altitudeSteps))) {
+        return TileAllNight;
+    }
+    return TileMixed;
+}
+
+void
+ESSunAltitudeTileCache::renderTile(const ESSunAltitudeTileKey &key,
+                                   double                     subsolarLatitude,
+                                   double                     subsolarLongitude,
+                                   unsigned char              *tile) const {
+    int tilesPerSide = 1 << key.zoom;
+    double pixelWidth = 2 * M_PI / tilesPerSide / _tileSize;
+    double westLongitude = -M_PI + key.x * 2 * M_PI / tilesPerSide;
+    std::vector<float> columnLongitudes(_tileSize);
+    for (int column = 0; column < _tileSize; column++) {
+        columnLongitudes[column] = fabs(remainder(westLongitude + (column + 0.5) * pixelWidth - subsolarLongitude, 2 * M_PI));
+    }
+    for (int row = 0; row < _tileSize; row++) {
+        double mapLatitude = mercatorLatitude(key.y + (row + 0.5) / _tileSize, tilesPerSide);
+        _table->renderMaskRow(subsolarLatitude, mapLatitude, &columnLongitudes[0], _tileSize, tile + row * _tileSize, _levelCount);
+    }
+}
+
+void
+ESSunAltitudeTileCache::insertTile(const ESSunAltitudeTileKey &key,
+                                   std::vector<unsigned char> &pixels) {
+    std::lock_guard<std::mutex> guard(_lock);
+    if (_tiles.find(key) != _tiles.end()) {
+        return;  // Another thread rendered it too
+    }
+    _lru.push_front(key);
+    CacheEntry &entry = _tiles[key];
+    entry.pixels.swap(pixels);
+    entry.lruPosition = _lru.begin();
+    while (_tiles.size() > _maxTiles) {
+        _tiles.erase(_lru.back());
+        _lru.pop_back();
+    }
+}
+
+void
+ESSunAltitudeTileCache::getTile(const ESSunAltitudeTileKey &key,
+                                double                     subsolarLatitude,
+                                double                     subsolarLongitude,
+                                unsigned char              *tile) {
+    ESAssert(key.zoom >= 0 && key.zoom < 31);
+    ESAssert(key.x >= 0 && key.x < (1 << key.zoom));
+    ESAssert(key.y >= 0 && key.y < (1 << key.zoom));
+    size_t tileBytes = (size_t)_tileSize * _tileSize;
+    switch (coverageForTile(key, subsolarLatitude, subsolarLongitude)) {
+      case TileAllDay:
+        memset(tile, 0, tileBytes);
+        return;
+      case TileAllNight:
+        memset(tile, 255, tileBytes);
+        return;
+      case TileMixed:
+        break;
+    }
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        CacheMap::iterator iter = _tiles.find(key);
+        if (iter != _tiles.end()) {
+            _lru.splice(_lru.begin(), _lru, iter->second.lruPosition);
+            memcpy(tile, &iter->second.pixels[0], tileBytes);
+            return;
+        }
+    }
+    std::vector<unsigned char> pixels(tileBytes);
+    renderTile(key, subsolarLatitude, subsolarLongitude, &pixels[0]);
+    memcpy(tile, &pixels[0], tileBytes);
+    insertTile(key, pixels);
+}
+
+int
+ESSunAltitudeTileCache::advanceTimeBucket(long long fromBucket,
+                                          long long toBucket,
+                                          double    subsolarLatitude,
+                                          double    subsolarLongitude) {
+    std::vector<ESSunAltitudeTileKey> keys;
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        for (LRUList::iterator iter = _lru.begin(); iter != _lru.end(); iter++) {
+            if (iter->timeBucket == fromBucket) {
+                ESSunAltitudeTileKey key = *iter;
+                key.timeBucket = toBucket;
+                if (_tiles.find(key) == _tiles.end()) {
+                    keys.push_back(key);
+                }
+            }
+        }
+    }
+    int tilesRendered = 0;
+    size_t tileBytes = (size_t)_tileSize * _tileSize;
+    for (size_t i = 0; i < keys.size(); i++) {
+        if (coverageForTile(keys[i], subsolarLatitude, subsolarLongitude) == TileMixed) {
+            std::vector<unsigned char> pixels(tileBytes);
+            renderTile(keys[i], subsolarLatitude, subsolarLongitude, &pixels[0]);
+            insertTile(keys[i], pixels);
+            tilesRendered++;
+        }
+    }
+    return tilesRendered;
+}
+
+void
+ESSunAltitudeTileCache::discardTimeBucketsBefore(long long timeBucket) {
+    std::lock_guard<std::mutex> guard(_lock);
+    LRUList::iterator iter = _lru.begin();
+    while (iter != _lru.end()) {
+        if (iter->timeBucket < timeBucket) {
+            _tiles.erase(*iter);
+            iter = _lru.erase(iter);
+        } else {
+            iter++;
+        }
+    }
+}
+
+size_t
+ESSunAltitudeTileCache::cachedTileCount() {
+    std::lock_guard<std::mutex> guard(_lock);
+    return _tiles.size();
+}
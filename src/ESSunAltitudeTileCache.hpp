@@ -0,0 +1,110 @@
+//
+//  ESSunAltitudeTileCache.hpp
+//
+//  Created 18 Oct 2026
+//  Copyright Emerald Sequoia LLC 2026. All rights reserved.
+//
+
+#ifndef _ESSUNALTITUDETILECACHE_HPP_
+#define _ESSUNALTITUDETILECACHE_HPP_
+
+#include <stddef.h>  // For size_t
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+class ESSunAltitudeTable;
+
+// Identifies one tile of the overlay at one time.  Time buckets are whatever the caller animates by (minutes since some
+// epoch, say); the cache only compares them, and it's up to the caller to pass the same subsolar point for the same bucket.
+struct ESSunAltitudeTileKey {
+    int                     zoom;
+    int                     x;
+    int                     y;
+    long long               timeBucket;
+
+    bool                    operator==(const ESSunAltitudeTileKey &other) const {
+        return zoom == other.zoom && x == other.x && y == other.y && timeBucket == other.timeBucket;
+    }
+};
+
+struct ESSunAltitudeTileKeyHash {
+    size_t                  operator()(const ESSunAltitudeTileKey &key) const {
+        size_t hash = (size_t)key.timeBucket;
+        hash = hash * 31 + key.zoom;
+        hash = hash * 1000003 + key.x;
+        hash = hash * 1000003 + key.y;
+        return hash;
+    }
+};
+
+/** This class serves the day/night overlay of ESSunAltitudeTable::renderMask as square tiles in the web-mercator XYZ scheme
+ *  (tile 0/0/0 is the whole world, x increases eastward from longitude -180, y increases southward from latitude 85.05), so that
+ *  maps can fetch just the tiles they show.
+ *  Most tiles lie entirely in day or entirely in night; those are recognized from the tile's bounds without rendering and
+ *  are never stored.  Only the tiles the terminator and twilight band cross are rendered, and those are kept in an LRU cache
+ *  keyed by tile and time bucket.  Moving on to the next time bucket (advanceTimeBucket) thus re-renders only the cached tiles
+ *  the band still crosses.
+ *  All methods may be called from any thread.
+*/
+class ESSunAltitudeTileCache {
+  public:
+                            ESSunAltitudeTileCache(const ESSunAltitudeTable *table,
+                                                   int                      tileSize = 256,
+                                                   int                      levelCount = 0,  // as for ESSunAltitudeTable::renderMask
+                                                   size_t                   maxTiles = 4096);
+
+    int                     tileSize() const { return _tileSize; }
+
+    // Fills tileSize() * tileSize() bytes at tile, one row after another, rendering the tile only if it's not already cached
+    void                    getTile(const ESSunAltitudeTileKey &key,
+                                    double                     subsolarLatitude,
+                                    double                     subsolarLongitude,
+                                    unsigned char              *tile);
+
+    // Makes the tiles cached for fromBucket available for toBucket as well, rendering only those the band crosses at toBucket.
+    // Returns the number of tiles rendered.
+    int                     advanceTimeBucket(long long fromBucket,
+                                              long long toBucket,
+                                              double    subsolarLatitude,
+                                              double    subsolarLongitude);
+
+    // Drops the cached tiles for buckets before the given one
+    void                    discardTimeBucketsBefore(long long timeBucket);
+
+    size_t                  cachedTileCount();
+
+  private:
+    enum TileCoverage {
+        TileAllDay,
+        TileAllNight,
+        TileMixed
+    };
+    typedef std::list<ESSunAltitudeTileKey> LRUList;
+    struct CacheEntry {
+        std::vector<unsigned char> pixels;
+        LRUList::iterator   lruPosition;
+    };
+    typedef std::unordered_map<ESSunAltitudeTileKey, CacheEntry, ESSunAltitudeTileKeyHash> CacheMap;
+
+    TileCoverage            coverageForTile(const ESSunAltitudeTileKey &key,
+                                            double                     subsolarLatitude,
+                                            double                     subsolarLongitude) const;
+    void                    renderTile(const ESSunAltitudeTileKey &key,
+                                       double                     subsolarLatitude,
+                                       double                     subsolarLongitude,
+                                       unsigned char              *tile) const;
+    void                    insertTile(const ESSunAltitudeTileKey &key,
+                                       std::vector<unsigned char> &pixels);  // Takes the pixels
+
+    const ESSunAltitudeTable *_table;
+    int                     _tileSize;
+    int                     _levelCount;
+    size_t                  _maxTiles;
+    std::mutex              _lock;  // Guards _tiles and _lru; rendering happens outside it
+    CacheMap                _tiles;
+    LRUList                 _lru;   // Most recently used first
+};
+
+#endif  // _ESSUNALTITUDETILECACHE_HPP_